@@ -136,17 +136,22 @@ void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color
     lv_disp_flush_ready(disp);
 }
 
-/*读取触摸板*/
+/*读取触摸板（中断模式：事件来自 CST820 队列）*/
+static lv_indev_t *touch_indev;
+
 void my_touchpad_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data)
 {
+    static CST820Event last = {}; /*未触摸*/
+    CST820Event event;
 
-    bool touched;
-    uint8_t gesture;
-    uint16_t touchX, touchY;
-
-    touched = touch.getTouch(&touchX, &touchY, &gesture);
+    /*没有新事件时保持上一次的状态，I2C 总线空闲*/
+    if (touch.readEvent(&event))
+    {
+        last = event;
+    }
+    data->continue_reading = touch.pending() > 0;
 
-    if (!touched)
+    if (!last.touched)
     {
         data->state = LV_INDEV_STATE_REL;
     }
@@ -155,8 +160,8 @@ void my_touchpad_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data)
         data->state = LV_INDEV_STATE_PR;
 
         /*Set the coordinates*/
-        data->point.x = touchX;
-        data->point.y = touchY;
+        data->point.x = last.x;
+        data->point.y = last.y;
     }
 }
 
@@ -182,6 +187,7 @@ void setup()
     tft.initDMA();      /* 初始化DMA */
 
     touch.begin(); /*初始化触摸板*/
+    touch.beginInterrupt(); /*TP_INT 中断读取*/
     digitalWrite(27, HIGH);
     tft.fillScreen(TFT_RED);
     delay(500);
@@ -212,7 +218,7 @@ void setup()
     lv_indev_drv_init(&indev_drv);
     indev_drv.type = LV_INDEV_TYPE_POINTER;
     indev_drv.read_cb = my_touchpad_read;
-    lv_indev_drv_register(&indev_drv);
+    touch_indev = lv_indev_drv_register(&indev_drv);
 
 #if 0
     /* 创建简单标签 */
@@ -241,6 +247,11 @@ void setup()
 
 void loop()
 {
+    /*有触摸事件时让读取定时器在本次 lv_timer_handler() 中立即运行，不等 LV_INDEV_DEF_READ_PERIOD*/
+    if (touch.pending())
+    {
+        lv_timer_ready(touch_indev->driver->read_timer);
+    }
     lv_timer_handler(); /* 让GUI完成它的工作 */
     delay(5);
 }
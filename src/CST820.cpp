@@ -11,14 +11,7 @@ CST820::CST820(int8_t sda_pin, int8_t scl_pin, int8_t rst_pin, int8_t int_pin)
 void CST820::begin(void)
 {
     // Initialize I2C
-    if (_sda != -1 && _scl != -1)
-    {
-        Wire.begin(_sda, _scl);
-    }
-    else
-    {
-        Wire.begin();
-    }
+    startBus();
 
     // Int Pin Configuration
     if (_int != -1)
@@ -46,52 +39,216 @@ void CST820::begin(void)
 
 bool CST820::getTouch(uint16_t *x, uint16_t *y, uint8_t *gesture)
 {
-    bool FingerIndex = false;
-    FingerIndex = (bool)i2c_read(0x02);
+    CST820Event event;
+    if (!readTouch(&event))
+    {
+        return false;
+    }
+    *x = event.x;
+    *y = event.y;
+    *gesture = event.gesture;
+    return event.touched;
+}
 
-    *gesture = i2c_read(0x01);
-    if (!(*gesture == SlideUp || *gesture == SlideDown))
+bool CST820::readTouch(CST820Event *event)
+{
+    // 一次读取 0x01..0x06：手势、手指数、X 高/低、Y 高/低
+    uint8_t data[6];
+    uint32_t t0 = micros();
+    uint8_t err = i2c_read_continuous(0x01, data, sizeof(data));
+    _lastReadUs = micros() - t0;
+    if (_lastReadUs > _maxReadUs)
+    {
+        _maxReadUs = _lastReadUs;
+    }
+    if (err)
     {
-        *gesture = None;
+        return false;
     }
 
-    uint8_t data[4];
-    i2c_read_continuous(0x03,data,4);
-    *x = ((data[0] & 0x0f) << 8) | data[1];
-    *y = ((data[2] & 0x0f) << 8) | data[3];
+    event->gesture = data[0];
+    event->x = ((data[2] & 0x0f) << 8) | data[3];
+    event->y = ((data[4] & 0x0f) << 8) | data[5];
+    event->touched = data[1] != 0;
+    return true;
+}
 
+bool CST820::beginAsync(UBaseType_t priority)
+{
+    if (_task != nullptr)
+    {
+        return false;
+    }
+    return xTaskCreatePinnedToCore(readerTask, "cst820", 3072, this, priority, &_task, 1) == pdPASS;
+}
 
-    return FingerIndex;
+bool CST820::requestRead(void)
+{
+    if (_task == nullptr)
+    {
+        return false;
+    }
+    _stampUs = micros();
+    _stampMs = millis();
+    xTaskNotifyGive(_task);
+    return true;
 }
 
-uint8_t CST820::i2c_read(uint8_t addr)
+bool CST820::beginInterrupt(UBaseType_t priority)
 {
-    uint8_t rdData;
-    uint8_t rdDataCount;
-    do
+    if (_int == -1 || !beginAsync(priority))
     {
-        Wire.beginTransmission(I2C_ADDR_CST820);
-        Wire.write(addr);
-        Wire.endTransmission(false); // Restart
-        rdDataCount = Wire.requestFrom(I2C_ADDR_CST820, 1);
-    } while (rdDataCount == 0);
-    while (Wire.available())
+        return false;
+    }
+
+    // begin() 把 INT 当输出拉低，这里改回输入：芯片在有触摸时输出低电平脉冲
+    pinMode(_int, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(_int), isr, this, FALLING);
+    return true;
+}
+
+void IRAM_ATTR CST820::isr(void *arg)
+{
+    CST820 *self = (CST820 *)arg;
+    BaseType_t woken = pdFALSE;
+    self->_irqCount++;
+    self->_stampUs = micros();
+    self->_stampMs = millis();
+    vTaskNotifyGiveFromISR(self->_task, &woken);
+    if (woken)
     {
-        rdData = Wire.read();
+        portYIELD_FROM_ISR();
+    }
+}
+
+void CST820::readerTask(void *arg)
+{
+    CST820 *self = (CST820 *)arg;
+    bool touched = false;
+    uint8_t lastGesture = None;
+    TickType_t wait = portMAX_DELAY;
+    for (;;)
+    {
+        // 多个脉冲 / 请求合并成一次读取；上次入队失败时限时等待，超时后重读重发
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        CST820Event event = {};
+        event.us = self->_stampUs;
+        event.ms = self->_stampMs;
+        if (!self->readTouch(&event))
+        {
+            // 总线错误：不发送错误数据；若手指还按着，报告一次抬起，界面不会卡在按下状态
+            if (!touched)
+            {
+                continue;
+            }
+            event.touched = false;
+            event.gesture = None;
+        }
+
+        // 手势寄存器在手指抬起前一直保持同一个值：每个手势只报告一次；
+        // 新的按下重新开始，同一手势可以再次报告
+        uint8_t gesture = event.gesture;
+        uint8_t prevGesture = (!touched && event.touched) ? (uint8_t)None : lastGesture;
+        if (event.gesture == prevGesture)
+        {
+            event.gesture = None;
+        }
+
+        // 已抬起且没有新手势的读数不入队
+        if (event.gesture == None && !event.touched && !touched)
+        {
+            wait = portMAX_DELAY;
+            continue;
+        }
+        if (!self->_events.push(event))
+        {
+            // 队列满（dropped()）：状态不更新，CST820_RETRY_MS 后重读，抬起不会丢失
+            wait = pdMS_TO_TICKS(CST820_RETRY_MS);
+            continue;
+        }
+        touched = event.touched;
+        lastGesture = gesture;
+        wait = portMAX_DELAY;
+    }
+}
+
+void CST820::startBus(void)
+{
+    if (_sda != -1 && _scl != -1)
+    {
+        Wire.begin(_sda, _scl);
+    }
+    else
+    {
+        Wire.begin();
+    }
+    Wire.setClock(CST820_I2C_CLOCK);
+    Wire.setTimeOut(CST820_I2C_TIMEOUT_MS);
+}
+
+void CST820::recoverBus(void)
+{
+    int8_t sda = _sda != -1 ? _sda : SDA;
+    int8_t scl = _scl != -1 ? _scl : SCL;
+
+    // 从机卡在传输中间会一直拉低 SDA：手动给 SCL 最多 9 个时钟，再发 STOP
+    Wire.end();
+    pinMode(sda, INPUT_PULLUP);
+    digitalWrite(scl, HIGH);
+    pinMode(scl, OUTPUT_OPEN_DRAIN);
+    for (uint8_t i = 0; i < 9 && digitalRead(sda) == LOW; i++)
+    {
+        digitalWrite(scl, LOW);
+        delayMicroseconds(5);
+        digitalWrite(scl, HIGH);
+        delayMicroseconds(5);
+    }
+    digitalWrite(sda, LOW);
+    pinMode(sda, OUTPUT_OPEN_DRAIN);
+    delayMicroseconds(5);
+    digitalWrite(sda, HIGH); // SCL 高电平时 SDA 上升 = STOP
+    delayMicroseconds(5);
+
+    startBus();
+    _busRecoveries++;
+}
+
+void CST820::i2c_result(uint8_t err)
+{
+    if (err == 0)
+    {
+        _failStreak = 0;
+        return;
+    }
+    _i2cErrors++;
+    if (err == 5) // I2C_ERROR_TIMEOUT
+    {
+        _i2cTimeouts++;
+    }
+    if (++_failStreak % CST820_RECOVER_AFTER == 0)
+    {
+        recoverBus();
     }
-    return rdData;
 }
 
 uint8_t CST820::i2c_read_continuous(uint8_t addr, uint8_t *data, uint32_t length)
 {
-  Wire.beginTransmission(I2C_ADDR_CST820);
-  Wire.write(addr);
-  if ( Wire.endTransmission(true))return -1;
-  Wire.requestFrom(I2C_ADDR_CST820, length);
-  for (int i = 0; i < length; i++) {
-    *data++ = Wire.read();
+  // 写寄存器地址后 repeated start，整个读取只有一次总线占用；超时有界，失败最多重试 CST820_I2C_RETRIES 次
+  for (uint8_t attempt = 0; attempt <= CST820_I2C_RETRIES; attempt++) {
+    Wire.beginTransmission(I2C_ADDR_CST820);
+    Wire.write(addr);
+    uint8_t err = Wire.endTransmission(false);
+    // 读到的字节不够（NACK / 提前结束）算普通错误，不算超时
+    if (!err && Wire.requestFrom(I2C_ADDR_CST820, length) != length) err = 4;
+    i2c_result(err);
+    if (err) continue;
+    for (int i = 0; i < length; i++) {
+      *data++ = Wire.read();
+    }
+    return 0;
   }
-  return 0;
+  return -1;
 }
 
 void CST820::i2c_write(uint8_t addr, uint8_t data)
@@ -99,7 +256,7 @@ void CST820::i2c_write(uint8_t addr, uint8_t data)
     Wire.beginTransmission(I2C_ADDR_CST820);
     Wire.write(addr);
     Wire.write(data);
-    Wire.endTransmission();
+    i2c_result(Wire.endTransmission());
 }
 
 uint8_t CST820::i2c_write_continuous(uint8_t addr, const uint8_t *data, uint32_t length)
@@ -109,6 +266,8 @@ uint8_t CST820::i2c_write_continuous(uint8_t addr, const uint8_t *data, uint32_t
   for (int i = 0; i < length; i++) {
     Wire.write(*data++);
   }
-  if ( Wire.endTransmission(true))return -1;
+  uint8_t err = Wire.endTransmission(true);
+  i2c_result(err);
+  if (err)return -1;
   return 0;
 }
\ No newline at end of file
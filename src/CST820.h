@@ -2,8 +2,15 @@
 #define _CST820_H
 
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "SpscRing.h"
 
 #define I2C_ADDR_CST820 0x15
+#define CST820_I2C_CLOCK 400000
+#define CST820_I2C_TIMEOUT_MS 5 //单次传输的上限（Wire 默认 50 ms）
+#define CST820_I2C_RETRIES 2
+#define CST820_RECOVER_AFTER 3  //连续失败次数，之后恢复总线（SCL 时钟 + STOP）
 
 //手势
 enum GESTURE
@@ -18,6 +25,20 @@ enum GESTURE
     LongPress = 0x0C   //长按
 };
 
+#define CST820_EVENT_QUEUE 16 //2 的幂
+#define CST820_RETRY_MS 10    //队列满时，读取任务隔这么久重读并重新入队
+
+//触摸事件（异步/中断模式下由读取任务放入无锁队列）
+struct CST820Event
+{
+    uint32_t us;     //INT 下降沿（或 requestRead）的时刻 micros()（只用于测量间隔，约 71 分钟回绕）
+    uint32_t ms;     //同一时刻的 millis()，和应用的时间戳同一时钟
+    uint16_t x;
+    uint16_t y;
+    uint8_t gesture; //芯片识别的手势 GESTURE，只在出现时报告一次，其余为 None
+    bool touched;    //false = 手指抬起
+};
+
 /**************************************************************************/
 /*!
     @brief  CST820 I2C CTP controller driver
@@ -31,10 +52,56 @@ public:
     void begin(void);
     bool getTouch(uint16_t *x, uint16_t *y, uint8_t *gesture);
 
+    // Asynchronous mode: requestRead() only wakes a reader task and returns at once;
+    // the task does the I2C read and queues a timestamped CST820Event, collected with
+    // readEvent(). Interrupt mode: the same task, woken by TP_INT (falling edge)
+    // instead, so there is no bus traffic while the panel is idle.
+    // The queue is a lock-free SPSC ring: the reader task is the only producer,
+    // readEvent() must be called from a single consumer task. When it is full the
+    // event is not lost: the task keeps its touch state, re-reads the panel every
+    // CST820_RETRY_MS and queues the then-current event (dropped() counts these).
+    // Do not call getTouch() once either mode is running.
+    bool beginAsync(UBaseType_t priority = 2);
+    bool beginInterrupt(UBaseType_t priority = 2);
+    bool requestRead(void);
+    bool readEvent(CST820Event *event) { return _events.pop(*event); }
+    uint32_t pending(void) const { return _events.size(); }
+    uint32_t interrupts(void) const { return _irqCount; }
+    uint32_t dropped(void) const { return _events.overflows(); }
+
+    // Bus time of the last getTouch() read and the worst seen so far [us]
+    uint32_t lastReadUs(void) const { return _lastReadUs; }
+    uint32_t maxReadUs(void) const { return _maxReadUs; }
+
+    // I2C health: every transfer is bounded by CST820_I2C_TIMEOUT_MS; i2cTimeouts()
+    // counts only transfers that hit it, short/NACKed reads are plain i2cErrors()
+    uint32_t i2cErrors(void) const { return _i2cErrors; }
+    uint32_t i2cTimeouts(void) const { return _i2cTimeouts; }
+    uint32_t busRecoveries(void) const { return _busRecoveries; }
+    bool online(void) const { return _failStreak < CST820_RECOVER_AFTER; }
+
 private:
     int8_t _sda, _scl, _rst, _int;
 
-    uint8_t i2c_read(uint8_t addr);
+    SpscRing<CST820Event, CST820_EVENT_QUEUE> _events;
+    TaskHandle_t _task = nullptr;
+    volatile uint32_t _irqCount = 0;
+    volatile uint32_t _stampUs = 0;
+    volatile uint32_t _stampMs = 0;
+    uint32_t _lastReadUs = 0;
+    uint32_t _maxReadUs = 0;
+    uint32_t _i2cErrors = 0;
+    uint32_t _i2cTimeouts = 0;
+    uint32_t _busRecoveries = 0;
+    uint32_t _failStreak = 0;
+
+    static void IRAM_ATTR isr(void *arg);
+    static void readerTask(void *arg);
+    bool readTouch(CST820Event *event);
+
+    void startBus(void);
+    void recoverBus(void);
+    void i2c_result(uint8_t err);
     uint8_t i2c_read_continuous(uint8_t addr, uint8_t *data, uint32_t length);
     void i2c_write(uint8_t addr, uint8_t data);
     uint8_t i2c_write_continuous(uint8_t addr, const uint8_t *data, uint32_t length);
@@ -0,0 +1,60 @@
+#ifndef _CST820_TOUCH_H
+#define _CST820_TOUCH_H
+
+#include <stdint.h>
+#include "CST820.h"
+#include "TouchInput.h"
+
+// Backend TouchInput dla panelu pojemnościowego: gesty rozpoznaje sam CST820,
+// zdarzenia przychodzą z kolejki sterownika (przerwanie TP_INT), bez odpytywania I2C.
+class Cst820Touch
+{
+public:
+    explicit Cst820Touch(CST820 &chip) : _chip(chip) {}
+
+    void begin(uint32_t)
+    {
+        _chip.begin();
+        _ready = _chip.beginInterrupt();
+    }
+
+    template <typename F>
+    void poll(uint32_t, F onEvent)
+    {
+        CST820Event ev;
+        while (_chip.readEvent(&ev))
+        {
+            _pressed = ev.touched;
+            Gesture g = gesture(ev.gesture);
+            // Znacznik millis() ze sterownika – micros()/1000 zawija się po ~71 min
+            if (g != GESTURE_NONE) onEvent(TouchEvent{ev.ms, g});
+        }
+    }
+
+    bool pressed() const { return _pressed; }
+    bool ready() const { return _ready; }
+    CST820 &chip() { return _chip; }
+
+    // Kody gestów układu -> wspólne gesty UI
+    static Gesture gesture(uint8_t hw)
+    {
+        switch (hw)
+        {
+        case SingleTap: return GESTURE_TAP;
+        case DoubleTap: return GESTURE_DOUBLE_TAP;
+        case LongPress: return GESTURE_LONG_PRESS;
+        case SlideLeft: return GESTURE_SWIPE_LEFT;
+        case SlideRight: return GESTURE_SWIPE_RIGHT;
+        case SlideUp: return GESTURE_SWIPE_UP;
+        case SlideDown: return GESTURE_SWIPE_DOWN;
+        default: return GESTURE_NONE;
+        }
+    }
+
+private:
+    CST820 &_chip;
+    bool _pressed = false;
+    bool _ready = false;
+};
+
+#endif
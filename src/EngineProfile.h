@@ -0,0 +1,98 @@
+#ifndef _ENGINE_PROFILE_H
+#define _ENGINE_PROFILE_H
+
+#include <stdint.h>
+
+// Punkty zmiany biegu dla biegów 1..N; bieg spoza listy (luz, nieznany) używa SHIFT_RPM
+template <uint16_t... Rpm>
+struct ShiftPoints
+{
+    static constexpr uint8_t COUNT = sizeof...(Rpm);
+    static constexpr uint16_t RPM[COUNT + 1] = {Rpm..., 0};
+
+    static constexpr bool allBelow(uint16_t limit)
+    {
+        for (uint8_t i = 0; i < COUNT; i++)
+            if (RPM[i] == 0 || RPM[i] >= limit) return false;
+        return true;
+    }
+};
+
+// Profil silnika – wszystkie parametry znane w czasie kompilacji.
+// PulsesPerCycle impulsów z cewki przypada na RevsPerCycle obrotów wału:
+//   4T, jedna iskra co 2 obroty  -> <1, 2>
+//   2T                           -> <1, 1>
+//   4T wasted spark (iskra co obrót) -> <1, 1>
+// Cała matematyka RPM to stałe liczone przez kompilator + mnożenie/dzielenie całkowite.
+// AlphaQ8/BetaQ8 to wzmocnienia filtra alfa-beta (RpmTracker.h) w Q8 (256 = 1.0),
+// PredictMs – o ile do przodu przewidujemy RPM, by skompensować opóźnienie wyświetlania.
+// Shift – punkty zmiany biegu per bieg (ShiftPoints<...>), domyślnie wszędzie ShiftRpm.
+template <uint8_t PulsesPerCycle, uint8_t RevsPerCycle,
+          uint16_t RedlineRpm, uint16_t ShiftRpm, uint16_t FlashRpm,
+          uint8_t AlphaQ8 = 128, uint8_t BetaQ8 = 40, uint8_t PredictMs = 40,
+          typename Shift = ShiftPoints<>>
+struct EngineProfile
+{
+    static_assert(PulsesPerCycle > 0 && RevsPerCycle > 0, "EngineProfile: zerowy cykl");
+    static_assert(ShiftRpm < FlashRpm, "EngineProfile: SHIFT_RPM musi byc ponizej FLASH_RPM");
+    static_assert(Shift::allBelow(FlashRpm), "EngineProfile: punkty zmiany biegu musza byc ponizej FLASH_RPM");
+
+    static constexpr uint8_t  PULSES_PER_CYCLE = PulsesPerCycle;
+    static constexpr uint8_t  REVS_PER_CYCLE   = RevsPerCycle;
+    static constexpr uint16_t REDLINE_RPM      = RedlineRpm; // początek czerwonej strefy na skali
+    static constexpr uint16_t SHIFT_RPM        = ShiftRpm;   // miganie LED zmiany biegu
+    static constexpr uint16_t FLASH_RPM        = FlashRpm;   // miganie ekranu (odcinka)
+    static constexpr uint16_t RPM_LIMIT        = 20000;      // fizyczny sufit odczytu
+    static constexpr uint8_t  TRACK_ALPHA_Q8   = AlphaQ8;
+    static constexpr uint8_t  TRACK_BETA_Q8    = BetaQ8;
+    static constexpr uint8_t  PREDICT_MS       = PredictMs;
+
+    // RPM = impulsy * 60000 * REVS / (PULSES * dtMs)
+    static constexpr uint32_t RPM_COUNT_K = 60000UL * RevsPerCycle / PulsesPerCycle;
+    // RPM = 60e6 * REVS / (PULSES * okresUs)
+    static constexpr uint32_t RPM_PERIOD_K = 60000000UL * RevsPerCycle / PulsesPerCycle;
+    static_assert(RPM_COUNT_K * PulsesPerCycle == 60000UL * RevsPerCycle, "EngineProfile: niecalkowita stala RPM");
+
+    // Okres impulsu przy RPM_LIMIT – krótsze odstępy to na pewno zakłócenia
+    static constexpr uint32_t MIN_PERIOD_US = RPM_PERIOD_K / RPM_LIMIT;
+
+    static inline uint16_t rpmFromCount(uint32_t pulses, uint32_t dtMs)
+    {
+        if (dtMs == 0) return 0;
+        uint32_t rpm = pulses * RPM_COUNT_K / dtMs;
+        return rpm > RPM_LIMIT ? RPM_LIMIT : (uint16_t)rpm;
+    }
+
+    static inline uint16_t rpmFromPeriodUs(uint32_t periodUs)
+    {
+        if (periodUs < MIN_PERIOD_US) return periodUs == 0 ? 0 : RPM_LIMIT;
+        return (uint16_t)(RPM_PERIOD_K / periodUs);
+    }
+
+    // Punkt zmiany biegu dla danego biegu (0 = luz, -1 = nieznany -> SHIFT_RPM)
+    static constexpr uint16_t shiftRpm(int8_t gear)
+    {
+        return gear >= 1 && gear <= Shift::COUNT ? Shift::RPM[gear - 1] : SHIFT_RPM;
+    }
+};
+
+// Dostępne profile (pulses, revs, redline, shift, flash, alfa, beta, predykcja, punkty zmiany 1..5)
+// 2T i wasted spark dają 2x więcej pomiarów na obrót, więc mogą mieć łagodniejsze wzmocnienia.
+// Na niskich biegach obroty rosną najszybciej, więc sygnał zmiany przychodzi tam wcześniej.
+typedef EngineProfile<1, 2, 14000, 6000, 10000, 128, 40, 40,
+                      ShiftPoints<5600, 5800, 6000, 6200, 6400>> Engine4T;
+typedef EngineProfile<1, 1, 12000, 8500, 11000,  96, 24, 30,
+                      ShiftPoints<8000, 8300, 8500, 8700, 9000>> Engine2T;
+typedef EngineProfile<1, 1, 11000, 7500,  9500,  96, 24, 30,
+                      ShiftPoints<7000, 7300, 7500, 7700, 8000>> Engine4TWastedSpark;
+
+// Wybór profilu flagą builda (platformio.ini), domyślnie 4T
+#if defined(ENGINE_PROFILE_2T)
+typedef Engine2T ActiveEngine;
+#elif defined(ENGINE_PROFILE_4T_WASTED)
+typedef Engine4TWastedSpark ActiveEngine;
+#else
+typedef Engine4T ActiveEngine;
+#endif
+
+#endif
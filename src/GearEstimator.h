@@ -0,0 +1,149 @@
+#ifndef _GEAR_ESTIMATOR_H
+#define _GEAR_ESTIMATOR_H
+
+#include <stdint.h>
+
+// Bieg z przełożenia RPM / prędkość koła. Gdy czujniki biegu są wiarygodne, uczy się
+// stosunku obrotów do prędkości dla każdego biegu; potem wskazuje bieg, gdy czujnika
+// brak, gdy się z nim nie zgadza albo gdy biegów jest więcej niż wejść (brakujące
+// przełożenia dopowiada z postępu geometrycznego sąsiednich biegów).
+// Tylko liczby całkowite; wołający podaje rpm i prędkość [0.1 km/h].
+template <uint8_t MaxGear = 6>
+class GearEstimator
+{
+public:
+    struct Estimate
+    {
+        int8_t gear;        // -1 = nie da się określić (postój, sprzęgło, luz)
+        uint8_t confidence; // 0..100
+    };
+
+    static constexpr uint16_t MIN_SPEED_X10 = 50; // poniżej 5 km/h przełożenie jest bezwartościowe
+    static constexpr uint16_t MIN_RPM = 1500;
+    static constexpr uint8_t LEARN_SHIFT = 3;      // średnia krocząca 1/8
+    static constexpr uint8_t TRUST_SAMPLES = 25;   // tyle stabilnych próbek, by bieg uznać za nauczony
+    static constexpr uint16_t STEADY_PERMILLE = 30; // zmiana przełożenia między próbkami przy puszczonym sprzęgle
+    static constexpr uint8_t EXTRAPOLATED_PCT = 70; // pewność przełożeń dopowiedzianych, nie nauczonych
+
+    // [rpm na km/h] w Q8; 0 = poza zakresem pomiaru
+    static uint32_t ratioQ8(uint16_t rpm, uint16_t speedX10)
+    {
+        if (rpm < MIN_RPM || speedX10 < MIN_SPEED_X10) return 0;
+        return (uint32_t)((uint64_t)rpm * 10 * 256 / speedX10);
+    }
+
+    // Próbka przy biegu potwierdzonym czujnikiem (1..MaxGear); uczy tylko w stanie ustalonym,
+    // żeby poślizg sprzęgła i chwile zmiany biegu nie psuły średniej
+    void learn(int8_t gear, uint16_t rpm, uint16_t speedX10)
+    {
+        uint32_t r = ratioQ8(rpm, speedX10);
+        bool steady = r != 0 && gear == _prevGear && _prevRatio != 0 &&
+                      permille(r, _prevRatio) <= STEADY_PERMILLE;
+        _prevGear = gear;
+        _prevRatio = r;
+        if (!steady || gear < 1 || gear > MaxGear) return;
+
+        uint8_t i = (uint8_t)(gear - 1);
+        if (_samples[i] == 0)
+            _ratio[i] = r;
+        else
+            _ratio[i] = (uint32_t)((int32_t)_ratio[i] + (((int32_t)r - (int32_t)_ratio[i]) >> LEARN_SHIFT));
+        if (_samples[i] < 0xFFFF) _samples[i]++;
+    }
+
+    // Bieg najbliższy bieżącemu przełożeniu. Pewność maleje liniowo od 100 (trafienie
+    // w nauczone przełożenie) do 0 w połowie drogi do przełożenia sąsiedniego biegu.
+    Estimate estimate(uint16_t rpm, uint16_t speedX10) const
+    {
+        Estimate e = {-1, 0};
+        uint32_t r = ratioQ8(rpm, speedX10);
+        if (r == 0) return e;
+
+        uint32_t cand[MaxGear];
+        uint8_t scale[MaxGear];
+        candidates(cand, scale);
+
+        int8_t best = -1;
+        uint32_t bestErr = 0xFFFFFFFF;
+        for (uint8_t i = 0; i < MaxGear; i++)
+        {
+            if (cand[i] == 0) continue;
+            uint32_t err = permille(r, cand[i]);
+            if (err < bestErr)
+            {
+                bestErr = err;
+                best = (int8_t)i;
+            }
+        }
+        if (best < 0) return e;
+
+        // Tolerancja: połowa względnej odległości do najbliższego sąsiada
+        uint32_t tol = 250;
+        for (int8_t j = (int8_t)(best - 1); j <= best + 1; j += 2)
+        {
+            if (j < 0 || j >= MaxGear || cand[j] == 0) continue;
+            uint32_t half = permille(cand[j], cand[best]) / 2;
+            if (half < tol) tol = half;
+        }
+        if (tol == 0 || bestErr >= tol) return e;
+
+        e.gear = (int8_t)(best + 1);
+        e.confidence = (uint8_t)((tol - bestErr) * scale[best] / tol);
+        return e;
+    }
+
+    bool learned(int8_t gear) const
+    {
+        return gear >= 1 && gear <= MaxGear && _samples[gear - 1] >= TRUST_SAMPLES;
+    }
+    uint32_t ratioQ8Of(int8_t gear) const { return gear >= 1 && gear <= MaxGear ? _ratio[gear - 1] : 0; }
+    uint16_t samples(int8_t gear) const { return gear >= 1 && gear <= MaxGear ? _samples[gear - 1] : 0; }
+
+    void reset()
+    {
+        for (uint8_t i = 0; i < MaxGear; i++)
+        {
+            _ratio[i] = 0;
+            _samples[i] = 0;
+        }
+        _prevGear = -1;
+        _prevRatio = 0;
+    }
+
+private:
+    // |a - b| / b [promile]
+    static uint32_t permille(uint32_t a, uint32_t b)
+    {
+        if (b == 0) return 0xFFFFFFFF;
+        uint32_t d = a > b ? a - b : b - a;
+        return (uint32_t)((uint64_t)d * 1000 / b);
+    }
+
+    // Przełożenia nauczone (pewność 100%) i dopowiedziane z dwóch sąsiadów w górę lub w dół
+    void candidates(uint32_t *cand, uint8_t *scale) const
+    {
+        for (uint8_t i = 0; i < MaxGear; i++)
+        {
+            cand[i] = learned((int8_t)(i + 1)) ? _ratio[i] : 0;
+            scale[i] = 100;
+        }
+        for (uint8_t i = 0; i < MaxGear; i++)
+        {
+            if (cand[i] != 0) continue;
+            uint32_t x = 0;
+            if (i >= 2 && learned((int8_t)i) && learned((int8_t)(i - 1)))
+                x = (uint32_t)((uint64_t)_ratio[i - 1] * _ratio[i - 1] / _ratio[i - 2]);
+            else if (i + 2 < MaxGear && learned((int8_t)(i + 2)) && learned((int8_t)(i + 3)))
+                x = (uint32_t)((uint64_t)_ratio[i + 1] * _ratio[i + 1] / _ratio[i + 2]);
+            cand[i] = x;
+            scale[i] = EXTRAPOLATED_PCT;
+        }
+    }
+
+    uint32_t _ratio[MaxGear] = {};
+    uint16_t _samples[MaxGear] = {};
+    int8_t _prevGear = -1;
+    uint32_t _prevRatio = 0;
+};
+
+#endif
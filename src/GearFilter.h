@@ -0,0 +1,137 @@
+#ifndef _GEAR_FILTER_H
+#define _GEAR_FILTER_H
+
+#include <stdint.h>
+#include "GearInput.h"
+
+// Stabilizacja biegu z surowego kodu pinów (GearInput::code):
+//  1) każdy pin ma własny integrator (całkuj-i-zrzuć) – stan zmienia się dopiero, gdy
+//     licznik dojdzie do 0 albo do integrateSamples, więc drgania styków są pomijane,
+//  2) kandydat na nowy bieg musi się utrzymać confirmUs,
+//  3) przejścia dozwolone tylko o ±1 bieg lub przez luz (układ 1-N-2 i N-1-2);
+//     niefizyczny skok (np. N -> 5) przyjmujemy dopiero po forceUs – gdy przegapiliśmy
+//     pośredni bieg, a nowy stan trzyma się stabilnie.
+// Czas podaje wołający (us), więc klasa działa też na hoście.
+class GearFilter
+{
+public:
+    static constexpr uint8_t PINS = 6;
+
+    GearFilter(uint8_t integrateSamples, uint32_t confirmUs, uint32_t forceUs)
+        : _integrateMax(integrateSamples ? integrateSamples : 1), _confirmUs(confirmUs), _forceUs(forceUs)
+    {
+    }
+
+    // Próbka surowego kodu (bit i = pin i aktywny); zwraca potwierdzony bieg (-1 = nieznany)
+    int8_t update(uint8_t rawCode, uint32_t nowUs)
+    {
+        uint8_t prevStable = _stable;
+        _integrating = false;
+        for (uint8_t i = 0; i < PINS; i++)
+        {
+            uint8_t bit = (uint8_t)(1U << i);
+            if (rawCode & bit)
+            {
+                if (_level[i] < _integrateMax && ++_level[i] == _integrateMax) _stable |= bit;
+            }
+            else if (_level[i] > 0 && --_level[i] == 0)
+            {
+                _stable &= (uint8_t)~bit;
+            }
+            if (_level[i] != 0 && _level[i] != _integrateMax) _integrating = true;
+        }
+
+        uint8_t e = GEAR_LUT.entries[_stable & 0x3F];
+        if (e & GearLut::MULTI)
+        {
+            // Kilka pinów stabilnie naraz – trzymamy ostatni bieg
+            if (_stable != prevStable) _multiPin++;
+            dropCandidate();
+            return _gear;
+        }
+        if ((e & GearLut::NONE) == GearLut::NONE)
+        {
+            // Żaden pin – bębenek między pozycjami, trzymamy ostatni bieg
+            dropCandidate();
+            return _gear;
+        }
+
+        int8_t seen = (int8_t)(e & GearLut::NONE);
+        if (seen == _gear)
+        {
+            dropCandidate();
+            return _gear;
+        }
+        if (seen != _candidate)
+        {
+            if (_candidate >= 0) _bounces++;
+            _candidate = seen;
+            _candidateSinceUs = nowUs;
+            _candidatePlausible = plausible(_gear, seen);
+            if (!_candidatePlausible) _implausible++;
+        }
+
+        uint32_t heldUs = nowUs - _candidateSinceUs;
+        if (_candidatePlausible ? heldUs >= _confirmUs : heldUs >= _forceUs)
+        {
+            if (!_candidatePlausible) _forced++;
+            _gear = _candidate;
+            _changes++;
+            _candidate = -1;
+        }
+        return _gear;
+    }
+
+    int8_t gear() const { return _gear; }
+    uint8_t stableCode() const { return _stable; }
+    // Czujnik pokazuje teraz dokładnie potwierdzony bieg (jeden pin, bez oczekującej zmiany)
+    bool settled() const
+    {
+        return _gear >= 0 && _candidate < 0 && _stable == (uint8_t)(1U << _gear);
+    }
+
+    // Trwa całkowanie któregoś pinu albo czeka kandydat – wołający powinien dalej próbkować
+    bool busy() const { return _integrating || _candidate >= 0; }
+
+    // Diagnostyka
+    uint32_t changes() const { return _changes; }          // potwierdzone zmiany biegu
+    uint32_t bounces() const { return _bounces; }          // kandydat zmienił się przed potwierdzeniem
+    uint32_t multiPin() const { return _multiPin; }        // kilka pinów aktywnych naraz
+    uint32_t implausible() const { return _implausible; }  // niefizyczne przejścia (odrzucone lub wymuszone)
+    uint32_t forced() const { return _forced; }            // niefizyczne przejścia przyjęte po forceUs
+    uint32_t faults() const { return _multiPin + _implausible; }
+
+    // ±1 bieg; luz sąsiaduje z 1 i 2 (N może leżeć pod 1 albo między 1 a 2)
+    static bool plausible(int8_t from, int8_t to)
+    {
+        if (from < 0) return true;
+        int8_t d = (int8_t)(to > from ? to - from : from - to);
+        if (d <= 1) return true;
+        return (from == 0 && to == 2) || (from == 2 && to == 0);
+    }
+
+private:
+    void dropCandidate()
+    {
+        if (_candidate >= 0) _bounces++;
+        _candidate = -1;
+    }
+
+    const uint8_t _integrateMax;
+    const uint32_t _confirmUs;
+    const uint32_t _forceUs;
+    uint8_t _level[PINS] = {};
+    uint8_t _stable = 0;
+    bool _integrating = false;
+    int8_t _gear = -1;
+    int8_t _candidate = -1;
+    bool _candidatePlausible = false;
+    uint32_t _candidateSinceUs = 0;
+    uint32_t _changes = 0;
+    uint32_t _bounces = 0;
+    uint32_t _multiPin = 0;
+    uint32_t _implausible = 0;
+    uint32_t _forced = 0;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef _GEAR_INPUT_H
+#define _GEAR_INPUT_H
+
+#include <stdint.h>
+
+// Odczyt czujników biegów jednym odczytem rejestrów wejść GPIO (IN: 0..31, IN1: 32..39)
+// i dekodowanie 6-bitowego kodu przez 64-pozycyjną tablicę generowaną w czasie kompilacji.
+// Piny podaje się w kolejności N, 1, 2, 3, 4, 5; czujniki są aktywne niskim stanem.
+struct GearDecode
+{
+    int8_t gear;   // 0 = luz, 1..5, -1 = brak aktywnego pinu
+    bool multiPin; // więcej niż jeden aktywny pin – kombinacja niefizyczna
+};
+
+// Pozycja tablicy: najniższy aktywny pin (priorytet jak dawniej: N przed 1 przed 2...)
+// w bitach 0..3 (0x0F = brak) plus flaga 0x80, gdy aktywnych pinów jest więcej
+struct GearLut
+{
+    static constexpr uint8_t NONE = 0x0F;
+    static constexpr uint8_t MULTI = 0x80;
+    uint8_t entries[64];
+};
+
+constexpr GearLut makeGearLut()
+{
+    GearLut t{};
+    for (uint8_t c = 0; c < 64; c++)
+    {
+        uint8_t e = GearLut::NONE;
+        uint8_t active = 0;
+        for (uint8_t i = 0; i < 6; i++)
+        {
+            if (c & (1U << i))
+            {
+                if (active == 0) e = i;
+                active++;
+            }
+        }
+        t.entries[c] = (uint8_t)(e | (active > 1 ? GearLut::MULTI : 0));
+    }
+    return t;
+}
+
+inline constexpr GearLut GEAR_LUT = makeGearLut();
+static_assert(GEAR_LUT.entries[0] == GearLut::NONE, "GearLut: pusty kod");
+static_assert(GEAR_LUT.entries[0x01] == 0 && GEAR_LUT.entries[0x20] == 5, "GearLut: pojedyncze piny");
+static_assert(GEAR_LUT.entries[0x03] == (0 | GearLut::MULTI), "GearLut: N + 1 to kombinacja niefizyczna");
+
+template <uint8_t... Pins>
+class GearInput
+{
+public:
+    static constexpr uint8_t COUNT = sizeof...(Pins);
+    static_assert(COUNT >= 1 && COUNT <= 6, "GearInput: od 1 do 6 pinow");
+    static constexpr uint8_t PINS[COUNT] = {Pins...};
+
+    // Maski liczone z listy pinów – który rejestr wejść w ogóle trzeba czytać
+    static constexpr uint32_t MASK_LO = ((Pins < 32 ? (1UL << (Pins & 31)) : 0UL) | ...);
+    static constexpr uint32_t MASK_HI = ((Pins >= 32 ? (1UL << (Pins & 31)) : 0UL) | ...);
+
+    // Bit i kodu = pin i-tego biegu aktywny (zwarty do masy); pętla o stałych
+    // granicach – kompilator rozwija ją do stałych przesunięć
+    static inline uint8_t code(uint32_t inLo, uint32_t inHi)
+    {
+        uint8_t c = 0;
+        for (uint8_t i = 0; i < COUNT; i++)
+        {
+            uint32_t reg = PINS[i] < 32 ? inLo : inHi;
+            c |= (uint8_t)(((reg >> (PINS[i] & 31)) & 1U) << i);
+        }
+        return (uint8_t)(~c) & ALL;
+    }
+
+    static inline GearDecode decode(uint8_t code)
+    {
+        uint8_t e = GEAR_LUT.entries[code & ALL];
+        GearDecode d;
+        d.gear = (e & GearLut::NONE) == GearLut::NONE ? -1 : (int8_t)(e & GearLut::NONE);
+        d.multiPin = (e & GearLut::MULTI) != 0;
+        return d;
+    }
+
+    static inline GearDecode sample(uint32_t inLo, uint32_t inHi) { return decode(code(inLo, inHi)); }
+
+private:
+    static constexpr uint8_t ALL = (uint8_t)((1U << COUNT) - 1);
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _GEAR_SCHEDULE_H
+#define _GEAR_SCHEDULE_H
+
+#include <stdint.h>
+
+// Kiedy zadanie czujników bierze próbkę pinów biegu (ta sama reguła w sensorTask
+// i w tools/replay/pin_arbiter_check):
+//   - od razu, gdy arbiter ma żądanie (zbocze albo jednorazowa próbka po oknie dotyku),
+//   - co sampleMs przez windowMs po zboczu albo dopóki filtr biegu nie rozstrzygnął
+//     (busy() – np. próbka kontrolna trafiła na zmianę bez zbocza),
+//   - poza tym rzadka próbka kontrolna co fallbackMs.
+// Okno odnawia tylko zbocze: próbka po oknie dotyku nie może go przedłużać,
+// inaczej każde okno dotyku podtrzymywałoby próbkowanie co sampleMs.
+// Czas podaje wołający (ms), więc klasa działa też na hoście.
+class GearSchedule
+{
+public:
+    GearSchedule(uint32_t sampleMs, uint32_t windowMs, uint32_t fallbackMs)
+        : _sampleMs(sampleMs), _windowMs(windowMs), _fallbackMs(fallbackMs), _lastEdgeMs(0 - windowMs)
+    {
+    }
+
+    // requested/edgeRequested = PinArbiter::gearRequested()/gearEdgeRequested()
+    bool due(uint32_t nowMs, bool requested, bool edgeRequested, bool filterBusy)
+    {
+        if (edgeRequested) _lastEdgeMs = nowMs;
+        _active = nowMs - _lastEdgeMs < _windowMs || filterBusy;
+        uint32_t sinceMs = nowMs - _lastSampleMs;
+        return requested || (_active && sinceMs >= _sampleMs) || sinceMs >= _fallbackMs;
+    }
+
+    // Próbka faktycznie pobrana (arbiter mógł odmówić – wtedy ponowienie w kolejnym takcie)
+    void sampled(uint32_t nowMs) { _lastSampleMs = nowMs; }
+
+    // Wynik ostatniego due(): trwa gęste próbkowanie po zboczu
+    bool active() const { return _active; }
+
+private:
+    uint32_t _sampleMs;
+    uint32_t _windowMs;
+    uint32_t _fallbackMs;
+    uint32_t _lastEdgeMs;
+    uint32_t _lastSampleMs = 0;
+    bool _active = false;
+};
+
+#endif
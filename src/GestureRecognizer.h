@@ -0,0 +1,139 @@
+#ifndef _GESTURE_RECOGNIZER_H
+#define _GESTURE_RECOGNIZER_H
+
+#include <stdint.h>
+
+// Gesty z przefiltrowanego strumienia dotyku (nacisk + pozycja w jednostkach ADC):
+// tap, podwójny tap, długie przytrzymanie i przeciągnięcia w czterech kierunkach.
+// Mała maszyna stanów bez alokacji; czas podaje wołający (ms), więc na hoście
+// odtwarza się ją z nagranych śladów (tools/replay/gesture_replay).
+enum Gesture : uint8_t
+{
+    GESTURE_NONE,
+    GESTURE_TAP,
+    GESTURE_DOUBLE_TAP,
+    GESTURE_LONG_PRESS,
+    GESTURE_SWIPE_LEFT,   // malejące x
+    GESTURE_SWIPE_RIGHT,  // rosnące x
+    GESTURE_SWIPE_UP,     // malejące y
+    GESTURE_SWIPE_DOWN,   // rosnące y
+};
+
+struct GestureConfig
+{
+    uint16_t tapMaxMs = 300;       // dłuższy nacisk bez ruchu to już nie tap
+    uint16_t doubleTapGapMs = 250; // 0 = bez podwójnego tapu (tap zgłaszany od razu)
+    uint16_t longPressMs = 800;
+    uint16_t swipeMinDist = 600;   // [LSB ADC] minimalne przesunięcie
+    uint16_t swipeMaxMs = 700;
+    uint16_t moveTolerance = 200;  // drżenie palca, które nie psuje tapu/przytrzymania
+    uint8_t swipeDominancePct = 60; // udział głównej osi w przesunięciu
+};
+
+class GestureRecognizer
+{
+public:
+    explicit GestureRecognizer(const GestureConfig &cfg = GestureConfig()) : _cfg(cfg) {}
+
+    const GestureConfig &config() const { return _cfg; }
+    void setConfig(const GestureConfig &cfg) { _cfg = cfg; }
+
+    // Jedna próbka strumienia; zwraca co najwyżej jeden gest
+    Gesture update(uint32_t nowMs, bool pressed, uint16_t x, uint16_t y)
+    {
+        switch (_state)
+        {
+        case IDLE:
+            if (pressed) press(nowMs, x, y, false);
+            return GESTURE_NONE;
+
+        case WAIT_SECOND:
+            if (pressed)
+            {
+                press(nowMs, x, y, true);
+                return GESTURE_NONE;
+            }
+            if (nowMs - _releaseMs > _cfg.doubleTapGapMs)
+            {
+                _state = IDLE;
+                return GESTURE_TAP;
+            }
+            return GESTURE_NONE;
+
+        case DOWN:
+            if (pressed)
+            {
+                track(x, y);
+                if (!_moved && nowMs - _downMs >= _cfg.longPressMs)
+                {
+                    _state = HELD;
+                    return GESTURE_LONG_PRESS;
+                }
+                return GESTURE_NONE;
+            }
+            return release(nowMs);
+
+        case HELD:
+            // Po długim przytrzymaniu czekamy na puszczenie – nic więcej z tego nacisku
+            if (!pressed) _state = IDLE;
+            return GESTURE_NONE;
+        }
+        return GESTURE_NONE;
+    }
+
+    void reset() { _state = IDLE; }
+
+private:
+    enum State : uint8_t { IDLE, DOWN, WAIT_SECOND, HELD };
+
+    void press(uint32_t nowMs, uint16_t x, uint16_t y, bool second)
+    {
+        _state = DOWN;
+        _second = second;
+        _downMs = nowMs;
+        _x0 = _x = x;
+        _y0 = _y = y;
+        _moved = false;
+    }
+
+    void track(uint16_t x, uint16_t y)
+    {
+        _x = x;
+        _y = y;
+        if (absDiff(_x, _x0) > _cfg.moveTolerance || absDiff(_y, _y0) > _cfg.moveTolerance) _moved = true;
+    }
+
+    Gesture release(uint32_t nowMs)
+    {
+        uint32_t heldMs = nowMs - _downMs;
+        _state = IDLE;
+        if (_moved)
+        {
+            int32_t dx = (int32_t)_x - _x0, dy = (int32_t)_y - _y0;
+            uint32_t ax = absDiff(_x, _x0), ay = absDiff(_y, _y0);
+            uint32_t major = ax > ay ? ax : ay;
+            if (heldMs > _cfg.swipeMaxMs || major < _cfg.swipeMinDist) return GESTURE_NONE;
+            if (major * 100 < (ax + ay) * _cfg.swipeDominancePct) return GESTURE_NONE; // po skosie
+            if (ax >= ay) return dx < 0 ? GESTURE_SWIPE_LEFT : GESTURE_SWIPE_RIGHT;
+            return dy < 0 ? GESTURE_SWIPE_UP : GESTURE_SWIPE_DOWN;
+        }
+        if (heldMs > _cfg.tapMaxMs) return GESTURE_NONE;
+        if (_second) return GESTURE_DOUBLE_TAP;
+        if (_cfg.doubleTapGapMs == 0) return GESTURE_TAP;
+        _state = WAIT_SECOND;
+        _releaseMs = nowMs;
+        return GESTURE_NONE;
+    }
+
+    static uint32_t absDiff(uint16_t a, uint16_t b) { return a > b ? a - b : b - a; }
+
+    GestureConfig _cfg;
+    State _state = IDLE;
+    bool _second = false;
+    bool _moved = false;
+    uint32_t _downMs = 0;
+    uint32_t _releaseMs = 0;
+    uint16_t _x0 = 0, _y0 = 0, _x = 0, _y = 0;
+};
+
+#endif
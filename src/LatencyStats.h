@@ -0,0 +1,57 @@
+#ifndef _LATENCY_STATS_H
+#define _LATENCY_STATS_H
+
+#include <stdint.h>
+
+// Histogram opóźnień o stałej szerokości koszyka – bez alokacji, tylko liczby całkowite.
+// Ostatni koszyk zbiera wszystko powyżej zakresu (Buckets * BucketUs).
+template <uint16_t Buckets = 512, uint16_t BucketUs = 500>
+class LatencyStats
+{
+public:
+    void record(uint32_t latencyUs)
+    {
+        uint32_t idx = latencyUs / BucketUs;
+        if (idx >= Buckets) idx = Buckets - 1;
+        if (_counts[idx] < 0xFFFF) _counts[idx]++;
+        _count++;
+        if (latencyUs > _maxUs) _maxUs = latencyUs;
+    }
+
+    // Górna granica koszyka, w którym wypada percentyl p (0..100), nie więcej niż maksimum
+    // (inaczej p99 z jednego koszyka potrafi wyjść ponad max)
+    uint32_t percentileUs(uint8_t p) const
+    {
+        if (_count == 0) return 0;
+        uint32_t target = (uint32_t)(((uint64_t)_count * p + 99) / 100);
+        if (target == 0) target = 1;
+        uint32_t seen = 0;
+        for (uint16_t i = 0; i < Buckets; i++)
+        {
+            seen += _counts[i];
+            if (seen >= target)
+            {
+                uint32_t edgeUs = (uint32_t)(i + 1) * BucketUs;
+                return edgeUs < _maxUs ? edgeUs : _maxUs;
+            }
+        }
+        return _maxUs;
+    }
+
+    uint32_t count() const { return _count; }
+    uint32_t maxUs() const { return _maxUs; }
+
+    void reset()
+    {
+        for (uint16_t i = 0; i < Buckets; i++) _counts[i] = 0;
+        _count = 0;
+        _maxUs = 0;
+    }
+
+private:
+    uint16_t _counts[Buckets] = {};
+    uint32_t _count = 0;
+    uint32_t _maxUs = 0;
+};
+
+#endif
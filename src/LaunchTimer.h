@@ -0,0 +1,155 @@
+#ifndef _LAUNCH_TIMER_H
+#define _LAUNCH_TIMER_H
+
+#include <stdint.h>
+
+// Pomiar przyspieszenia 0-50 / 0-100 km/h i 60 m ze znaczników czasu impulsów koła.
+// Uzbraja się po postoju, startuje na pierwszym zboczu Halla, a chwile przekroczenia
+// progów interpoluje między zboczami – dokładność rzędu pojedynczych us, nie taktu pętli.
+class LaunchTimer
+{
+public:
+    enum State : uint8_t { IDLE, ARMED, RUNNING, DONE };
+
+    struct Result
+    {
+        uint32_t t50Us;  // 0 = nie osiągnięto
+        uint32_t t100Us;
+        uint32_t t60mUs;
+    };
+
+    static constexpr uint16_t TARGET_50_X10 = 500;
+    static constexpr uint16_t TARGET_100_X10 = 1000;
+    static constexpr uint32_t TARGET_DIST_UM = 60UL * 1000 * 1000;
+    static constexpr uint32_t ARM_HOLD_US = 1000000;   // tyle postoju, by uzbroić
+    static constexpr uint32_t RUN_TIMEOUT_US = 30000000; // bezpiecznik przebiegu
+    static constexpr uint32_t STOP_US = 2000000;         // brak zboczy tak długo = zatrzymanie
+    static constexpr uint8_t HISTORY = 5;
+
+    LaunchTimer() {}
+    explicit LaunchTimer(uint32_t umPerPulse) : _umPerPulse(umPerPulse) {}
+
+    // Każde zbocze Halla (z WheelSpeed::poll)
+    void onWheelEdge(uint32_t edgeUs)
+    {
+        if (_state == ARMED)
+        {
+            _state = RUNNING;
+            _t0 = edgeUs;
+            _lastEdgeUs = edgeUs;
+            _lastMidUs = 0;
+            _lastSpeedX10 = 0;
+            _distUm = 0;
+            _cur = Result{0, 0, 0};
+            return;
+        }
+        if (_state != RUNNING) return;
+
+        uint32_t periodUs = edgeUs - _lastEdgeUs;
+        if (periodUs == 0) return;
+        uint32_t prevRel = _lastEdgeUs - _t0;
+
+        // Dystans: liniowo w obrębie odcinka między magnesami
+        if (_cur.t60mUs == 0 && _distUm + _umPerPulse >= TARGET_DIST_UM)
+        {
+            uint32_t need = TARGET_DIST_UM - _distUm;
+            _cur.t60mUs = prevRel + (uint32_t)((uint64_t)periodUs * need / _umPerPulse);
+        }
+        _distUm += _umPerPulse;
+
+        // Prędkość średnia odcinka przypisana do jego środka, interpolacja między środkami
+        uint16_t speedX10 = (uint16_t)((uint64_t)_umPerPulse * 36 / periodUs);
+        uint32_t midRel = prevRel + periodUs / 2;
+        crossing(_cur.t50Us, TARGET_50_X10, speedX10, midRel);
+        crossing(_cur.t100Us, TARGET_100_X10, speedX10, midRel);
+        _lastSpeedX10 = speedX10;
+        _lastMidUs = midRel;
+        _lastEdgeUs = edgeUs;
+
+        if (_cur.t100Us && _cur.t60mUs) finish();
+    }
+
+    // Wołane z pętli głównej: uzbrajanie po postoju, limity czasu
+    void update(uint32_t nowUs, uint16_t speedX10)
+    {
+        switch (_state)
+        {
+        case IDLE:
+        case DONE:
+            if (speedX10 != 0)
+            {
+                _stillSinceValid = false;
+            }
+            else if (!_stillSinceValid)
+            {
+                _stillSinceValid = true;
+                _stillSinceUs = nowUs;
+            }
+            else if (nowUs - _stillSinceUs >= ARM_HOLD_US)
+            {
+                _state = ARMED;
+            }
+            break;
+        case ARMED:
+            break;
+        case RUNNING:
+            // Zatrzymanie (brak zboczy) albo przekroczony czas – kończymy z tym, co zmierzono
+            if (nowUs - _lastEdgeUs > STOP_US || nowUs - _t0 > RUN_TIMEOUT_US) finish();
+            break;
+        }
+    }
+
+    State state() const { return _state; }
+    const Result &current() const { return _cur; }
+    uint32_t elapsedUs(uint32_t nowUs) const { return _state == RUNNING ? nowUs - _t0 : 0; }
+
+    // Historia: 0 = najnowszy wynik
+    uint8_t historyCount() const { return _historyCount; }
+    const Result &history(uint8_t i) const
+    {
+        return _history[(_historyHead + HISTORY - 1 - i) % HISTORY];
+    }
+    uint32_t runs() const { return _runs; }
+
+private:
+    void crossing(uint32_t &slot, uint16_t target, uint16_t speedX10, uint32_t midRel)
+    {
+        if (slot != 0 || speedX10 < target) return;
+        // (_lastMidUs, _lastSpeedX10) -> (midRel, speedX10); na starcie punkt (0, 0)
+        uint32_t span = midRel - _lastMidUs;
+        uint32_t dv = speedX10 - _lastSpeedX10;
+        uint32_t need = target > _lastSpeedX10 ? target - _lastSpeedX10 : 0;
+        slot = _lastMidUs + (dv ? (uint32_t)((uint64_t)span * need / dv) : 0);
+        if (slot == 0) slot = 1;
+    }
+
+    void finish()
+    {
+        _state = DONE;
+        _stillSinceValid = false;
+        if (_cur.t50Us || _cur.t100Us || _cur.t60mUs)
+        {
+            _history[_historyHead] = _cur;
+            _historyHead = (_historyHead + 1) % HISTORY;
+            if (_historyCount < HISTORY) _historyCount++;
+            _runs++;
+        }
+    }
+
+    uint32_t _umPerPulse = 0;
+    State _state = IDLE;
+    uint32_t _t0 = 0;
+    uint32_t _lastEdgeUs = 0;
+    uint32_t _lastMidUs = 0;
+    uint16_t _lastSpeedX10 = 0;
+    uint32_t _distUm = 0;
+    uint32_t _stillSinceUs = 0;
+    bool _stillSinceValid = false;
+    Result _cur = {0, 0, 0};
+    Result _history[HISTORY] = {};
+    uint8_t _historyHead = 0;
+    uint8_t _historyCount = 0;
+    uint32_t _runs = 0;
+};
+
+#endif
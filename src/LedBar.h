@@ -0,0 +1,96 @@
+#ifndef _LED_BAR_H
+#define _LED_BAR_H
+
+#include <stdint.h>
+
+// Listwa LED zmiany biegu (WS2812, kolejność bajtów GRB): RPM -> klatka kolorów.
+// Progi zapalania każdej diody dla każdego biegu oraz kolory liczy kompilator
+// z profilu silnika (EngineProfile::shiftRpm/FLASH_RPM), więc w locie zostaje
+// tylko porównanie RPM z tablicą. Bez Arduino – ten sam kod renderuje klatki
+// w firmware (sterownik RMT) i na hoście (tools/replay/led_bar_sim).
+template <typename Profile, uint8_t Leds>
+struct LedBarTable
+{
+    static_assert(Leds >= 2, "LedBarTable: co najmniej 2 diody");
+    static constexpr uint8_t GEARS = 6;       // 0 = luz/nieznany (SHIFT_RPM), 1..5
+    static constexpr uint8_t START_PCT = 60;  // listwa rusza od 60% punktu zmiany
+
+    uint16_t on[GEARS][Leds];  // RPM zapalenia diody i na biegu g
+    uint8_t grb[Leds][3];      // kolor diody: zielony -> żółty -> czerwony
+
+    constexpr LedBarTable() : on(), grb()
+    {
+        for (uint8_t g = 0; g < GEARS; g++)
+        {
+            uint16_t shift = Profile::shiftRpm((int8_t)g);
+            uint16_t start = (uint16_t)((uint32_t)shift * START_PCT / 100);
+            for (uint8_t i = 0; i < Leds; i++)
+                on[g][i] = (uint16_t)(start + (uint32_t)(shift - start) * i / Leds);
+        }
+        for (uint8_t i = 0; i < Leds; i++)
+        {
+            uint8_t pct = (uint8_t)((uint16_t)i * 100 / (Leds - 1));
+            uint8_t r = pct < 50 ? 0 : 255;
+            uint8_t gr = pct < 50 ? 255 : (pct < 80 ? 160 : 0);
+            grb[i][0] = gr;
+            grb[i][1] = r;
+            grb[i][2] = 0;
+        }
+    }
+};
+
+template <typename Profile, uint8_t Leds>
+class LedBar
+{
+public:
+    static constexpr uint8_t LEDS = Leds;
+    static constexpr uint16_t FRAME_BYTES = (uint16_t)Leds * 3;
+    static constexpr LedBarTable<Profile, Leds> TABLE{};
+
+    static constexpr uint8_t SHIFT_BLINK_HZ = 8;   // cała listwa na niebiesko w punkcie zmiany
+    static constexpr uint8_t FLASH_BLINK_HZ = 16;  // cała listwa na czerwono przy FLASH_RPM
+
+    explicit LedBar(uint8_t brightness = 64) : _brightness(brightness) {}
+
+    void setBrightness(uint8_t b) { _brightness = b; }
+    uint8_t brightness() const { return _brightness; }
+
+    // Klatka do out[FRAME_BYTES]; zwraca liczbę zapalonych diod
+    uint8_t render(uint16_t rpm, int8_t gear, uint32_t nowUs, uint8_t *out) const
+    {
+        uint8_t g = gear >= 1 && gear < LedBarTable<Profile, Leds>::GEARS ? (uint8_t)gear : 0;
+        if (rpm >= Profile::FLASH_RPM)
+            return fill(out, blink(nowUs, FLASH_BLINK_HZ), 0, 255, 0);
+        if (rpm >= Profile::shiftRpm((int8_t)g))
+            return fill(out, blink(nowUs, SHIFT_BLINK_HZ), 0, 0, 255);
+
+        uint8_t lit = 0;
+        for (uint8_t i = 0; i < Leds; i++)
+        {
+            bool on = rpm > 0 && rpm >= TABLE.on[g][i];
+            for (uint8_t c = 0; c < 3; c++)
+                out[i * 3 + c] = on ? scale(TABLE.grb[i][c]) : 0;
+            lit += on;
+        }
+        return lit;
+    }
+
+private:
+    uint8_t fill(uint8_t *out, bool on, uint8_t g, uint8_t r, uint8_t b) const
+    {
+        for (uint8_t i = 0; i < Leds; i++)
+        {
+            out[i * 3 + 0] = on ? scale(g) : 0;
+            out[i * 3 + 1] = on ? scale(r) : 0;
+            out[i * 3 + 2] = on ? scale(b) : 0;
+        }
+        return on ? Leds : 0;
+    }
+
+    static bool blink(uint32_t nowUs, uint8_t hz) { return ((nowUs / (500000UL / hz)) & 1) == 0; }
+    uint8_t scale(uint8_t c) const { return (uint8_t)(((uint16_t)c * (_brightness + 1)) >> 8); }
+
+    uint8_t _brightness;
+};
+
+#endif
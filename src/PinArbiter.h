@@ -0,0 +1,109 @@
+#ifndef _PIN_ARBITER_H
+#define _PIN_ARBITER_H
+
+#include <stdint.h>
+
+// Podział czasu pinów wspólnych dla rezystancyjnego dotyku i czujników biegów.
+// Arbiter jest jedynym właścicielem trybu tych pinów:
+//   - gear(): próbka biegu tylko w trybie biegu (INPUT_PULLUP) i po czasie ustalenia,
+//   - touch(): okno pomiaru dotyku – wycisza przerwania biegów, oddaje piny funkcji
+//     pomiaru, po niej przywraca INPUT_PULLUP i odlicza settleUs zanim bieg znów
+//     zostanie odczytany. Zbocza zgubione w oknie pokrywa jednorazowa próbka po oknie
+//     (gearRequested(), ale nie gearEdgeRequested() – to nie jest zbocze i nie może
+//     przedłużać próbkowania po zboczu, inaczej każde okno dotyku by je odnawiało).
+//   - requestGear(): żądanie próbki biegu (zbocze); dopóki nie zostanie obsłużone,
+//     touch() odmawia – próbka biegu czeka więc najwyżej jedno okno dotyku + settleUs
+//     (maxGearBlockUs()) plus takt wołającego.
+// Dostęp do sprzętu przez Hal (micros, muteGear, gearMode + funkcje pomiaru dotyku),
+// więc na hoście da się sprawdzić, że oba tryby nigdy się nie przeplatają.
+template <typename Hal>
+class PinArbiter
+{
+public:
+    enum Owner : uint8_t { OWNER_GEAR, OWNER_TOUCH };
+
+    PinArbiter(Hal &hal, uint32_t settleUs) : _hal(hal), _settleUs(settleUs) {}
+
+    // Wołać w każdym obiegu pętli: kończy ustalanie po oknie dotyku
+    void service()
+    {
+        if (_restoring && gearReady()) finishRestore();
+    }
+
+    void requestGear() { _gearRequested = true; }
+    // Czeka próbka biegu: po zboczu albo jednorazowa po oknie dotyku
+    bool gearRequested() const { return _gearRequested || _restoreSampleDue; }
+    // Czeka próbka po zgłoszonym zboczu
+    bool gearEdgeRequested() const { return _gearRequested; }
+
+    // Próbka biegu; false = piny zajęte lub jeszcze się ustalają (ponowić w kolejnym takcie)
+    template <typename F>
+    bool gear(F sample)
+    {
+        service();
+        if (_owner != OWNER_GEAR || _restoring)
+        {
+            _gearDeferred++;
+            return false;
+        }
+        sample();
+        _gearRequested = false;
+        _restoreSampleDue = false;
+        return true;
+    }
+
+    // Okno dotyku: measure(hal) steruje pinami dowolnie, po nim arbiter przywraca tryb biegu
+    template <typename F>
+    bool touch(F measure)
+    {
+        service();
+        if (_owner != OWNER_GEAR || _restoring || gearRequested()) return false;
+        uint32_t t0 = _hal.micros();
+        _hal.muteGear(true);
+        _owner = OWNER_TOUCH;
+        measure(_hal);
+        _hal.gearMode();
+        _owner = OWNER_GEAR;
+        _restoring = true;
+        uint32_t t1 = _hal.micros();
+        _readyUs = t1 + _settleUs;
+        _touchUs += t1 - t0;
+        uint32_t blockUs = _readyUs - t0;
+        if (blockUs > _maxGearBlockUs) _maxGearBlockUs = blockUs;
+        _touchWindows++;
+        return true;
+    }
+
+    Owner owner() const { return _owner; }
+    bool restoring() const { return _restoring; }
+    uint32_t maxGearBlockUs() const { return _maxGearBlockUs; }
+    uint32_t touchWindows() const { return _touchWindows; }
+    // Łączny czas okien dotyku (bez ustalania) – koszt pomiaru dotyku
+    uint32_t touchUs() const { return _touchUs; }
+    uint32_t gearDeferred() const { return _gearDeferred; }
+
+private:
+    bool gearReady() const { return (int32_t)(_hal.micros() - _readyUs) >= 0; }
+
+    void finishRestore()
+    {
+        _restoring = false;
+        _hal.muteGear(false);
+        // Bieg mógł się zmienić w oknie bez zgłoszonego zbocza
+        _restoreSampleDue = true;
+    }
+
+    Hal &_hal;
+    const uint32_t _settleUs;
+    Owner _owner = OWNER_GEAR;
+    bool _restoring = false;
+    bool _gearRequested = false;
+    bool _restoreSampleDue = false;
+    uint32_t _readyUs = 0;
+    uint32_t _maxGearBlockUs = 0;
+    uint32_t _touchWindows = 0;
+    uint32_t _touchUs = 0;
+    uint32_t _gearDeferred = 0;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef _PULSE_CAPTURE_H
+#define _PULSE_CAPTURE_H
+
+#include <stdint.h>
+#include "SpscRing.h"
+
+// Przechwytywanie zboczy: ISR podaje znacznik czasu [us], filtr odrzuca drgania
+// krótsze niż debounceUs, a zaakceptowane zbocza trafiają do kolejki dla pętli głównej.
+template <uint16_t Capacity>
+class PulseCapture
+{
+public:
+    explicit PulseCapture(uint32_t debounceUs) : _debounceUs(debounceUs) {}
+
+    // Wołane z ISR – bez blokad, bez alokacji
+    inline __attribute__((always_inline)) void onEdge(uint32_t nowUs)
+    {
+        if (_hasLast && nowUs - _lastEdgeUs < _debounceUs)
+        {
+            _rejected++;
+            return;
+        }
+        _hasLast = true;
+        _lastEdgeUs = nowUs;
+        _edges.push(nowUs);
+    }
+
+    inline bool pop(uint32_t &edgeUs) { return _edges.pop(edgeUs); }
+
+    uint32_t rejected() const { return _rejected; }
+    uint32_t overflows() const { return _edges.overflows(); }
+
+private:
+    SpscRing<uint32_t, Capacity> _edges;
+    const uint32_t _debounceUs;
+    volatile uint32_t _lastEdgeUs = 0;
+    volatile uint32_t _rejected = 0;
+    volatile bool _hasLast = false;
+};
+
+#endif
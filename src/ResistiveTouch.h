@@ -0,0 +1,230 @@
+#ifndef _RESISTIVE_TOUCH_H
+#define _RESISTIVE_TOUCH_H
+
+#include <stdint.h>
+#include "GestureRecognizer.h"
+#include "TouchFrontEnd.h"
+#include "TouchInput.h"
+
+// Próg nacisku liczony od spoczynku płytki (odczyt bez palca)
+struct TouchCalibration
+{
+    int16_t baseX;
+    int16_t baseY;
+    int16_t thrPressY;
+    int16_t thrReleaseY;
+};
+
+struct ResistiveTouchConfig
+{
+    uint32_t calibMs = 1200;     // spoczynek mierzony po tym czasie od begin()
+    int16_t pressDeltaY = 250;   // nacisk: Y powyżej spoczynku o tyle...
+    int16_t releaseDeltaY = 120; // ...puszczenie: poniżej spoczynku + tyle (histereza)
+    int16_t deltaMarginX = 250;  // nacisk także przy X powyżej spoczynku o tyle
+    uint16_t idleZ = 150;        // Z1 poniżej = panel na pewno wolny (rękawica też daje nacisk)
+    uint32_t driftIdleMs = 3000; // tyle ciszy, zanim spoczynek zacznie podążać za odczytem
+    uint8_t driftShift = 4;      // krok podążania: 1/16 różnicy na próbkę
+};
+
+// Backend TouchInput dla 4-przewodowego panelu rezystancyjnego: pomiar w oknie arbitra
+// pinów wspólnych z biegami, lekkie wygładzenie EMA, autokalibracja spoczynku,
+// histereza nacisku i gesty programowe (GestureRecognizer).
+// Kalibracja: zapisana (begin z kalibracją) działa od pierwszej próbki; bez niej spoczynek
+// jest mierzony dopiero po calibMs ciszy (Z1 < idleZ), więc palec/rękawica na ekranie
+// przy starcie odracza kalibrację zamiast ją psuć. Po kalibracji spoczynek powoli podąża
+// za dryfem płytki, ale tylko gdy panel jest wyraźnie wolny (calibrationVersion() rośnie).
+// Nieaktualna zapisana kalibracja (np. spoczynek powyżej starego progu) trzymałaby nacisk
+// bez końca: nacisk przy Z1 < idleZ przez driftIdleMs = kalibracja od nowa ze spoczynku.
+template <typename FrontEnd, typename Arbiter>
+class ResistiveTouch
+{
+public:
+    ResistiveTouch(const FrontEnd &frontEnd, Arbiter &arbiter,
+                   const ResistiveTouchConfig &cfg = ResistiveTouchConfig(),
+                   const GestureConfig &gestures = GestureConfig())
+        : _frontEnd(frontEnd), _arbiter(arbiter), _cfg(cfg), _gestures(gestures) {}
+
+    void begin(uint32_t nowMs, const TouchCalibration *stored = nullptr)
+    {
+        _calibStartMs = nowMs;
+        _calibrated = false;
+        _pressed = false;
+        _primed = false;
+        _idle = false;
+        _stuck = false;
+        _gestures.reset();
+        if (stored && validCalibration(*stored)) setCalibration(*stored);
+    }
+
+    template <typename F>
+    void poll(uint32_t nowMs, F onEvent)
+    {
+        TouchReading r = {};
+        // Piny wspólne z biegami – pomiar tylko w oknie arbitra, który potem przywraca INPUT_PULLUP
+        if (!_arbiter.touch([&](auto &hal) { r = _frontEnd.measure(hal); })) return;
+        _reading = r;
+        // Seria bez wystarczającej liczby zgodnych próbek – pomijamy, filtr nie dostaje śmieci
+        if (!r.valid) return;
+
+        // Mediana serii już tłumi szum – wystarczy lekkie wygładzenie całkowite (0.7/0.3);
+        // pierwsza próbka startuje filtr, żeby zapisana kalibracja działała od razu
+        if (_primed)
+        {
+            _emaY = (_emaY * 7 + r.y * 3 + 5) / 10;
+            _emaX = (_emaX * 7 + r.x * 3 + 5) / 10;
+        }
+        else
+        {
+            _emaY = r.y;
+            _emaX = r.x;
+            _primed = true;
+        }
+        bool quiet = r.z < _cfg.idleZ;
+
+        if (!_calibrated)
+        {
+            // Okno kalibracji liczy się od ostatniego nacisku
+            if (!quiet) _calibStartMs = nowMs;
+            if (nowMs - _calibStartMs < _cfg.calibMs) return;
+            setCalibration(restCalibration());
+        }
+
+        bool active = _emaY >= _cal.thrPressY || _emaX >= _cal.baseX + _cfg.deltaMarginX;
+        if (!_pressed && active)
+        {
+            _pressed = true;
+        }
+        else if (_pressed && _emaY <= _cal.thrReleaseY && _emaX <= _cal.baseX + _cfg.deltaMarginX / 2)
+        {
+            _pressed = false;
+        }
+
+        releaseStuck(nowMs, quiet);
+        trackDrift(nowMs, quiet);
+
+        // Pozycja dla gestów prosto z serii (mediana już odfiltrowała szum) i tylko przy realnym
+        // nacisku: EMA przy nacisku i puszczeniu jedzie między spoczynkiem a punktem dotyku,
+        // więc każdy tap wyglądałby na przeciągnięcie
+        if (!quiet)
+        {
+            _touchX = r.x;
+            _touchY = r.y;
+        }
+        _samples++;
+        Gesture g = _gestures.update(nowMs, _pressed, _touchX, _touchY);
+        if (g != GESTURE_NONE) onEvent(TouchEvent{nowMs, g});
+    }
+
+    bool pressed() const { return _pressed; }
+    bool calibrated() const { return _calibrated; }
+    const TouchCalibration &calibration() const { return _cal; }
+
+    void setCalibration(const TouchCalibration &cal)
+    {
+        _cal = cal;
+        _calibrated = true;
+        _calVersion++;
+    }
+
+    // Zmienia się przy każdej nowej kalibracji i kroku dryfu – sygnał do zapisu
+    // (także po kalibracji od nowa przy zawieszonym nacisku – stuckReleases())
+    uint32_t calibrationVersion() const { return _calVersion; }
+
+    // Sprawdzenie kalibracji wczytanej z pamięci (12-bitowy ADC, progi nad spoczynkiem)
+    static bool validCalibration(const TouchCalibration &cal)
+    {
+        return cal.baseX >= 0 && cal.baseX < 4096 && cal.baseY >= 0 && cal.baseY < 4096 &&
+               cal.thrReleaseY > cal.baseY && cal.thrPressY > cal.thrReleaseY && cal.thrPressY < 4096 + 512;
+    }
+
+    // Bieżący spoczynek jako kalibracja (z progami z konfiguracji)
+    TouchCalibration restCalibration() const
+    {
+        return TouchCalibration{(int16_t)_emaX, (int16_t)_emaY, (int16_t)(_emaY + _cfg.pressDeltaY),
+                                (int16_t)(_emaY + _cfg.releaseDeltaY)};
+    }
+
+    // Diagnostyka: ostatnia seria, wygładzona pozycja, punkt dotyku i liczba próbek podanych do gestów
+    const TouchReading &lastReading() const { return _reading; }
+    uint32_t samples() const { return _samples; }
+    uint32_t stuckReleases() const { return _stuckReleases; }
+    uint16_t touchX() const { return _touchX; }
+    uint16_t touchY() const { return _touchY; }
+    int emaX() const { return _emaX; }
+    int emaY() const { return _emaY; }
+
+private:
+    static int absInt(int v) { return v < 0 ? -v : v; }
+
+    // Nacisk bez Z1 przez driftIdleMs: progi nie pasują do płytki, kalibracja od nowa
+    void releaseStuck(uint32_t nowMs, bool quiet)
+    {
+        if (!_pressed || !quiet)
+        {
+            _stuck = false;
+            return;
+        }
+        if (!_stuck)
+        {
+            _stuck = true;
+            _stuckSinceMs = nowMs;
+            return;
+        }
+        if (nowMs - _stuckSinceMs < _cfg.driftIdleMs) return;
+        setCalibration(restCalibration());
+        _pressed = false;
+        _stuck = false;
+        _stuckReleases++;
+    }
+
+    // Spoczynek podąża za wolnym dryfem tylko przy wyraźnie wolnym panelu:
+    // bez nacisku, Z1 < idleZ i odczyt blisko spoczynku przez driftIdleMs
+    void trackDrift(uint32_t nowMs, bool quiet)
+    {
+        int dx = _emaX - _cal.baseX, dy = _emaY - _cal.baseY;
+        bool idle = quiet && !_pressed && absInt(dy) < _cfg.releaseDeltaY / 2 && absInt(dx) < _cfg.deltaMarginX / 4;
+        if (!idle)
+        {
+            _idle = false;
+            return;
+        }
+        if (!_idle)
+        {
+            _idle = true;
+            _idleSinceMs = nowMs;
+            return;
+        }
+        if (nowMs - _idleSinceMs < _cfg.driftIdleMs || (dx == 0 && dy == 0)) return;
+        int stepX = dx / (1 << _cfg.driftShift), stepY = dy / (1 << _cfg.driftShift);
+        if (!stepX && dx) stepX = dx > 0 ? 1 : -1;
+        if (!stepY && dy) stepY = dy > 0 ? 1 : -1;
+        TouchCalibration cal = _cal;
+        cal.baseX = (int16_t)(cal.baseX + stepX);
+        cal.baseY = (int16_t)(cal.baseY + stepY);
+        cal.thrPressY = (int16_t)(cal.thrPressY + stepY);
+        cal.thrReleaseY = (int16_t)(cal.thrReleaseY + stepY);
+        setCalibration(cal);
+    }
+
+    const FrontEnd &_frontEnd;
+    Arbiter &_arbiter;
+    ResistiveTouchConfig _cfg;
+    GestureRecognizer _gestures;
+    TouchCalibration _cal = {};
+    TouchReading _reading = {};
+    uint32_t _calibStartMs = 0;
+    uint32_t _samples = 0;
+    uint32_t _calVersion = 0;
+    uint32_t _idleSinceMs = 0;
+    uint32_t _stuckSinceMs = 0;
+    uint32_t _stuckReleases = 0;
+    int _emaX = 0, _emaY = 0;
+    uint16_t _touchX = 0, _touchY = 0;
+    bool _calibrated = false;
+    bool _pressed = false;
+    bool _primed = false;
+    bool _idle = false;
+    bool _stuck = false;
+};
+
+#endif
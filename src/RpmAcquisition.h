@@ -0,0 +1,50 @@
+#ifndef _RPM_ACQUISITION_H
+#define _RPM_ACQUISITION_H
+
+#include <stdint.h>
+#include "PulseCapture.h"
+#include "RpmTracker.h"
+
+// Cały tor pomiaru RPM: zbocza z ISR -> kolejka -> filtr alfa-beta.
+// Bez odwołań do Arduino – czas podaje wołający (micros() w firmware,
+// wirtualny zegar w tools/replay), więc ten sam kod działa na hoście.
+template <typename Profile, uint16_t Capacity = 128>
+class RpmAcquisition
+{
+public:
+    explicit RpmAcquisition(uint32_t debounceUs) : _capture(debounceUs) {}
+
+    // Kontekst przerwania
+    inline __attribute__((always_inline)) void onEdge(uint32_t nowUs) { _capture.onEdge(nowUs); }
+
+    // Kontekst pętli: przetwórz zaległe zbocza, zwraca ich liczbę
+    uint32_t poll()
+    {
+        uint32_t n = 0;
+        uint32_t edgeUs;
+        while (_capture.pop(edgeUs))
+        {
+            _tracker.update(edgeUs);
+            n++;
+        }
+        return n;
+    }
+
+    uint16_t rpmAt(uint32_t nowUs, uint32_t horizonMs = Profile::PREDICT_MS) const
+    {
+        return _tracker.rpmAt(nowUs, horizonMs);
+    }
+
+    const RpmTracker<Profile> &tracker() const { return _tracker; }
+    // Diagnostyka: zgubione iskry oraz zakłócenia (podwójne wyzwolenia + odrzucone przez filtr ISR)
+    uint32_t missedPulses() const { return _tracker.missedPulses(); }
+    uint32_t noisePulses() const { return _tracker.extraPulses() + _capture.rejected(); }
+    uint32_t rejected() const { return _capture.rejected(); }
+    uint32_t overflows() const { return _capture.overflows(); }
+
+private:
+    PulseCapture<Capacity> _capture;
+    RpmTracker<Profile> _tracker;
+};
+
+#endif
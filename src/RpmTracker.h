@@ -0,0 +1,161 @@
+#ifndef _RPM_TRACKER_H
+#define _RPM_TRACKER_H
+
+#include <stdint.h>
+#include "EngineProfile.h"
+
+// Filtr alfa-beta śledzący RPM i jego przyrost [rpm/s] z kolejnych okresów impulsów.
+// Arytmetyka stałoprzecinkowa Q4 (rpm * 16), wzmocnienia z profilu silnika.
+// rpmAt() przewiduje RPM na zadany horyzont, kompensując opóźnienie ekranu i LED.
+template <typename Profile>
+class RpmTracker
+{
+public:
+    static constexpr uint16_t STALL_RPM = 300; // poniżej – silnik uznajemy za zgaszony
+    static constexpr uint32_t STALL_US = Profile::RPM_PERIOD_K / STALL_RPM;
+    static constexpr int32_t MAX_RATE = 60000; // [rpm/s] – szybciej silnik fizycznie się nie rozkręca
+
+    // Klasyfikacja okresu względem oczekiwanego z bieżącej estymaty
+    enum PulseClass : uint8_t
+    {
+        PULSE_OK,     // okres zgodny z oczekiwanym
+        PULSE_MISSED, // okres ~k razy dłuższy – zgubione iskry, pomiar dzielony przez k
+        PULSE_EXTRA,  // okres za krótki – podwójne wyzwolenie/zakłócenie, zbocze pominięte
+        PULSE_RELOCK  // start, zgaśnięcie albo seria anomalii – filtr zaczyna od nowa
+    };
+    // Wynik anomalii: +3 za anomalię, -1 za poprawny okres. Przekroczenie progu oznacza,
+    // że filtr zgubił rytm (np. złapał połowę/podwójną częstotliwość) – ufamy nowemu rytmowi.
+    static constexpr uint8_t RELOCK_SCORE = 9;
+
+    // Kolejne zaakceptowane zbocze [us]
+    PulseClass update(uint32_t edgeUs)
+    {
+        if (!_hasEdge)
+        {
+            _hasEdge = true;
+            _lastEdgeUs = edgeUs;
+            return PULSE_RELOCK;
+        }
+        uint32_t dtUs = edgeUs - _lastEdgeUs;
+        if (dtUs == 0) return PULSE_EXTRA;
+
+        if (!_locked || dtUs > STALL_US)
+        {
+            // Pierwszy okres albo start po zgaśnięciu – bez historii prędkości
+            relock(edgeUs, dtUs);
+            return PULSE_RELOCK;
+        }
+
+        int32_t pred = _x + (int32_t)((int64_t)_v * dtUs / 1000000);
+        if (pred <= 0)
+        {
+            relock(edgeUs, dtUs);
+            return PULSE_RELOCK;
+        }
+        uint32_t periodUs = dtUs;
+        PulseClass cls = PULSE_OK;
+        {
+            uint32_t expUs = (uint32_t)(((uint64_t)Profile::RPM_PERIOD_K << 4) / (uint32_t)pred);
+            if (dtUs < expUs - expUs * 2 / 5)
+            {
+                // Za krótko po poprzedniej iskrze – zbocze pomijamy, czas odniesienia zostaje
+                if (anomaly())
+                {
+                    relock(edgeUs, dtUs);
+                    return PULSE_RELOCK;
+                }
+                _extraPulses++;
+                return PULSE_EXTRA;
+            }
+            uint32_t k = (dtUs + expUs / 2) / expUs;
+            uint32_t dev = dtUs > k * expUs ? dtUs - k * expUs : k * expUs - dtUs;
+            if (k >= 2 && dev < expUs / 4)
+            {
+                if (anomaly())
+                {
+                    relock(edgeUs, dtUs);
+                    return PULSE_RELOCK;
+                }
+                _missedPulses += k - 1;
+                periodUs = dtUs / k;
+                cls = PULSE_MISSED;
+            }
+            else if (_anomalyScore > 0)
+            {
+                _anomalyScore--;
+            }
+        }
+        _lastEdgeUs = edgeUs;
+
+        int32_t z = (int32_t)Profile::rpmFromPeriodUs(periodUs) << 4;
+        int32_t r = z - pred;
+        _x = pred + ((int32_t)Profile::TRACK_ALPHA_Q8 * r) / 256;
+        _v += (int32_t)((int64_t)Profile::TRACK_BETA_Q8 * r * 1000000 / 256 / periodUs);
+        if (_x < 0) _x = 0;
+        if (_x > ((int32_t)Profile::RPM_LIMIT << 4)) _x = (int32_t)Profile::RPM_LIMIT << 4;
+        if (_v > (MAX_RATE << 4)) _v = MAX_RATE << 4;
+        if (_v < -(MAX_RATE << 4)) _v = -(MAX_RATE << 4);
+        return cls;
+    }
+
+    // RPM przewidziane na chwilę nowUs + horizonMs
+    uint16_t rpmAt(uint32_t nowUs, uint32_t horizonMs = Profile::PREDICT_MS) const
+    {
+        if (!_locked) return 0;
+        uint32_t sinceUs = nowUs - _lastEdgeUs;
+        if (sinceUs > STALL_US) return 0;
+
+        int64_t est = _x + (int64_t)_v * (sinceUs + horizonMs * 1000) / 1000000;
+        // Brak impulsu dłużej niż okres => silnik nie może kręcić szybciej niż K / sinceUs
+        if (sinceUs > 0)
+        {
+            int64_t bound = (int64_t)Profile::rpmFromPeriodUs(sinceUs) << 4;
+            if (est > bound) est = bound;
+        }
+        if (est < 0) est = 0;
+        if (est > ((int64_t)Profile::RPM_LIMIT << 4)) est = (int64_t)Profile::RPM_LIMIT << 4;
+        return (uint16_t)(est >> 4);
+    }
+
+    int32_t rateRpmPerSec() const { return _v / 16; }
+    uint32_t lastEdgeUs() const { return _lastEdgeUs; }
+    bool locked() const { return _locked; }
+
+    // Liczniki diagnostyczne (narastające od startu)
+    uint32_t missedPulses() const { return _missedPulses; }
+    uint32_t extraPulses() const { return _extraPulses; }
+
+    void reset()
+    {
+        _hasEdge = _locked = false;
+        _x = _v = 0;
+        _anomalyScore = 0;
+    }
+
+private:
+    bool anomaly()
+    {
+        _anomalyScore += 3;
+        return _anomalyScore >= RELOCK_SCORE;
+    }
+
+    void relock(uint32_t edgeUs, uint32_t dtUs)
+    {
+        _lastEdgeUs = edgeUs;
+        _x = (int32_t)Profile::rpmFromPeriodUs(dtUs) << 4;
+        _v = 0;
+        _locked = dtUs <= STALL_US;
+        _anomalyScore = 0;
+    }
+
+    int32_t _x = 0;  // RPM w Q4
+    int32_t _v = 0;  // rpm/s w Q4
+    uint32_t _lastEdgeUs = 0;
+    bool _hasEdge = false;
+    bool _locked = false;
+    uint8_t _anomalyScore = 0;
+    uint32_t _missedPulses = 0;
+    uint32_t _extraPulses = 0;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef _SEQLOCK_H
+#define _SEQLOCK_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Wersjonowana migawka (seqlock): jeden pisarz, dowolna liczba czytelników.
+// Licznik nieparzysty = zapis w toku. Czytelnik kopiuje dane i powtarza, jeśli licznik
+// zmienił się w trakcie – bez blokad i bez maskowania przerwań po żadnej stronie.
+// version() pozwala tanio sprawdzić, czy od ostatniego odczytu coś się zmieniło.
+template <typename T>
+class Seqlock
+{
+public:
+    void write(const T &value)
+    {
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _data = value;
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Spójna kopia; zwraca wersję, której dotyczy. Nie wołać z ISR na rdzeniu pisarza –
+    // tam tylko tryRead(), bo przerwany pisarz nie dokończy zapisu.
+    uint32_t read(T &out) const
+    {
+        uint32_t v;
+        while (!tryRead(out, v)) {}
+        return v;
+    }
+
+    bool tryRead(T &out, uint32_t &version, uint8_t attempts = 4) const
+    {
+        while (attempts--)
+        {
+            uint32_t s1 = _seq.load(std::memory_order_acquire);
+            if (s1 & 1) continue;
+            out = _data;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_seq.load(std::memory_order_relaxed) == s1)
+            {
+                version = s1 >> 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t version() const { return _seq.load(std::memory_order_acquire) >> 1; }
+
+private:
+    T _data{};
+    std::atomic<uint32_t> _seq{0};
+};
+
+#endif
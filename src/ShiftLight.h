@@ -0,0 +1,101 @@
+#ifndef _SHIFT_LIGHT_H
+#define _SHIFT_LIGHT_H
+
+#include <stdint.h>
+
+// Logika lampki zmiany biegu: jasność PWM (0..255) w funkcji RPM przewidzianego
+// z nachylenia o lookaheadMs do przodu (czas reakcji kierowcy):
+//   shiftRpm(bieg) - rampRpm .. shiftRpm  -> narastanie jasności minDuty..maxDuty,
+//   od shiftRpm                           -> miganie blinkHz,
+//   od FLASH_RPM                          -> miganie flashBlinkHz (odcinka).
+// Faza migania liczona z czasu bezwzględnego – nie zależy od taktu wołającego.
+// Tylko liczby całkowite, czas podaje wołający, więc działa też na hoście.
+template <typename Profile>
+class ShiftLight
+{
+public:
+    struct Config
+    {
+        uint16_t rampRpm = 1500;     // szerokość narastania przed punktem zmiany
+        uint8_t minDuty = 8;         // jasność na początku rampy
+        uint8_t maxDuty = 255;
+        uint8_t blinkHz = 8;         // miganie w punkcie zmiany
+        uint8_t flashBlinkHz = 16;   // miganie przy FLASH_RPM
+        uint16_t lookaheadMs = 120;  // predykcja z nachylenia RPM
+    };
+
+    // Dane wejściowe z toru RPM (publikowane przez zadanie czujników)
+    struct Input
+    {
+        uint16_t rpm;          // RPM w chwili sampleUs
+        int32_t rateRpmPerSec; // nachylenie z filtra alfa-beta
+        uint32_t sampleUs;
+        uint32_t edgeUs;       // zbocze, z którego pochodzi rpm (pomiar opóźnienia)
+        int8_t gear;           // -1 = nieznany
+    };
+
+    // Decyzja progowa bez fazy migania – jej zmiana to nowa informacja dla kierowcy
+    enum Zone : uint8_t
+    {
+        ZONE_OFF,
+        ZONE_RAMP,
+        ZONE_SHIFT,
+        ZONE_FLASH
+    };
+
+    ShiftLight() {}
+    explicit ShiftLight(const Config &cfg) : _cfg(cfg) {}
+
+    const Config &config() const { return _cfg; }
+    void setConfig(const Config &cfg) { _cfg = cfg; }
+
+    // RPM przewidziane na nowUs + lookaheadMs; tylko narastanie obrotów przyspiesza sygnał
+    uint16_t predictedRpm(const Input &in, uint32_t nowUs) const
+    {
+        if (in.rpm == 0) return 0;
+        int32_t rate = in.rateRpmPerSec > 0 ? in.rateRpmPerSec : 0;
+        uint32_t aheadUs = (nowUs - in.sampleUs) + (uint32_t)_cfg.lookaheadMs * 1000;
+        if (aheadUs > 1000000) aheadUs = 1000000;
+        int32_t rpm = (int32_t)in.rpm + (int32_t)((int64_t)rate * aheadUs / 1000000);
+        return rpm > Profile::RPM_LIMIT ? Profile::RPM_LIMIT : (uint16_t)rpm;
+    }
+
+    Zone zone(const Input &in, uint32_t nowUs) const
+    {
+        uint16_t rpm = predictedRpm(in, nowUs);
+        uint16_t shift = Profile::shiftRpm(in.gear);
+        if (in.rpm >= Profile::FLASH_RPM) return ZONE_FLASH;
+        if (rpm >= shift) return ZONE_SHIFT;
+        uint16_t start = shift > _cfg.rampRpm ? shift - _cfg.rampRpm : 0;
+        if (rpm < start || _cfg.rampRpm == 0) return ZONE_OFF;
+        return ZONE_RAMP;
+    }
+
+    uint8_t duty(const Input &in, uint32_t nowUs) const
+    {
+        switch (zone(in, nowUs))
+        {
+        case ZONE_FLASH: return blink(nowUs, _cfg.flashBlinkHz);
+        case ZONE_SHIFT: return blink(nowUs, _cfg.blinkHz);
+        case ZONE_RAMP: break;
+        default: return 0;
+        }
+        uint16_t rpm = predictedRpm(in, nowUs);
+        uint16_t shift = Profile::shiftRpm(in.gear);
+        uint16_t start = shift > _cfg.rampRpm ? shift - _cfg.rampRpm : 0;
+        uint32_t span = (uint32_t)(_cfg.maxDuty - _cfg.minDuty);
+        return (uint8_t)(_cfg.minDuty + span * (rpm - start) / _cfg.rampRpm);
+    }
+
+private:
+    uint8_t blink(uint32_t nowUs, uint8_t hz) const
+    {
+        if (hz == 0) return _cfg.maxDuty;
+        uint32_t halfUs = 500000UL / hz;
+        return (nowUs / halfUs) & 1 ? 0 : _cfg.maxDuty;
+    }
+
+    Config _cfg;
+};
+
+#endif
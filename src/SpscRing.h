@@ -0,0 +1,51 @@
+#ifndef _SPSC_RING_H
+#define _SPSC_RING_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Bezblokadowy bufor pierścieniowy: jeden producent (np. ISR), jeden konsument.
+// Capacity musi być potęgą dwójki; przy pełnym buforze nowy element jest odrzucany.
+template <typename T, uint16_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing: Capacity musi byc potega 2");
+
+public:
+    inline __attribute__((always_inline)) bool push(const T &item)
+    {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= Capacity)
+        {
+            _overflows++;
+            return false;
+        }
+        _buf[head & (Capacity - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline bool pop(T &item)
+    {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _buf[tail & (Capacity - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline uint32_t size() const
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    uint32_t overflows() const { return _overflows; }
+
+private:
+    T _buf[Capacity];
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+    volatile uint32_t _overflows = 0;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef _TOUCH_FRONT_END_H
+#define _TOUCH_FRONT_END_H
+
+#include <stdint.h>
+
+// Przód toru dotyku rezystancyjnego: seria próbek ADC na oś (burst z DMA w firmware)
+// -> mediana -> średnia tylko z próbek bliskich medianie. Same liczby całkowite.
+// Pomiar 4-przewodowy w trzech fazach (w oknie PinArbiter::touch()):
+//   Y: zasil X+ / X-, czytaj Y+      X: zasil Y+ / Y-, czytaj X+
+//   Z: Y+ = VCC, X- = GND, czytaj X+ (Z1) – bez nacisku płytka X leży na masie,
+//      więc Z rośnie od 0 razem z siłą nacisku.
+// Hal dostarcza: drive(pin, high), release(pin), delayUs(us), burst(pin, out, n) -> liczba próbek.
+struct TouchBurstConfig
+{
+    uint16_t settleUs = 40;    // po przełączeniu zasilania płytek, przed pierwszą próbką
+    uint8_t samples = 16;      // próbek na oś (max TouchFrontEnd::MAX_SAMPLES)
+    uint16_t outlierLsb = 64;  // próbki dalej od mediany nie wchodzą do średniej
+};
+
+struct TouchReading
+{
+    uint16_t x;      // surowe 0..4095 (bez kalibracji ekranu)
+    uint16_t y;
+    uint16_t z;      // nacisk (Z1), 0 = brak
+    uint8_t used;    // najmniejsza liczba próbek, które przeszły filtr (jakość pomiaru)
+    bool valid;      // każda oś miała dość próbek
+};
+
+template <uint8_t PinYP, uint8_t PinXP, uint8_t PinXM, uint8_t PinYM>
+class TouchFrontEnd
+{
+public:
+    static constexpr uint8_t MAX_SAMPLES = 32;
+
+    explicit TouchFrontEnd(const TouchBurstConfig &cfg = TouchBurstConfig()) : _cfg(cfg)
+    {
+        if (_cfg.samples > MAX_SAMPLES) _cfg.samples = MAX_SAMPLES;
+        if (_cfg.samples == 0) _cfg.samples = 1;
+    }
+
+    const TouchBurstConfig &config() const { return _cfg; }
+
+    template <typename Hal>
+    TouchReading measure(Hal &hal) const
+    {
+        TouchReading r = {0, 0, 0, MAX_SAMPLES, true};
+        // Y: zasil X, Y- wolne
+        hal.drive(PinXP, true);
+        hal.drive(PinXM, false);
+        hal.release(PinYM);
+        hal.release(PinYP);
+        r.y = axis(hal, PinYP, r);
+        // X: zasil Y, X- wolne
+        hal.drive(PinYP, true);
+        hal.drive(PinYM, false);
+        hal.release(PinXM);
+        hal.release(PinXP);
+        r.x = axis(hal, PinXP, r);
+        // Z1: Y+ zostaje na VCC, X- na masę, Y- wolne
+        hal.drive(PinXM, false);
+        hal.release(PinYM);
+        r.z = axis(hal, PinXP, r);
+        return r;
+    }
+
+    // Mediana serii i średnia próbek w promieniu outlierLsb od niej
+    static uint16_t robust(const uint16_t *s, uint8_t n, uint16_t outlierLsb, uint8_t *used)
+    {
+        if (n == 0)
+        {
+            *used = 0;
+            return 0;
+        }
+        uint16_t v[MAX_SAMPLES];
+        if (n > MAX_SAMPLES) n = MAX_SAMPLES;
+        for (uint8_t i = 0; i < n; i++)
+        {
+            // sortowanie przez wstawianie – do 32 elementów szybsze niż cokolwiek innego
+            uint16_t x = s[i];
+            uint8_t j = i;
+            while (j > 0 && v[j - 1] > x)
+            {
+                v[j] = v[j - 1];
+                j--;
+            }
+            v[j] = x;
+        }
+        uint16_t med = v[n / 2];
+        uint32_t sum = 0;
+        uint8_t k = 0;
+        for (uint8_t i = 0; i < n; i++)
+        {
+            uint16_t d = v[i] > med ? v[i] - med : med - v[i];
+            if (d > outlierLsb) continue;
+            sum += v[i];
+            k++;
+        }
+        *used = k;
+        return (uint16_t)((sum + k / 2) / k); // k >= 1: mediana zawsze przechodzi
+    }
+
+private:
+    template <typename Hal>
+    uint16_t axis(Hal &hal, uint8_t pin, TouchReading &r) const
+    {
+        uint16_t buf[MAX_SAMPLES];
+        hal.delayUs(_cfg.settleUs);
+        uint8_t n = hal.burst(pin, buf, _cfg.samples);
+        uint8_t used = 0;
+        uint16_t v = robust(buf, n, _cfg.outlierLsb, &used);
+        if (used < r.used) r.used = used;
+        if (used < (_cfg.samples + 1) / 2) r.valid = false;
+        return v;
+    }
+
+    TouchBurstConfig _cfg;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef _TOUCH_INPUT_H
+#define _TOUCH_INPUT_H
+
+#include <stdint.h>
+#include "GestureRecognizer.h"
+
+// Zdarzenie dotyku dla UI – takie samo dla każdego panelu
+struct TouchEvent
+{
+    uint32_t ms;     // chwila wykrycia (zegar millis())
+    Gesture gesture;
+};
+
+// Wejście dotykowe z backendem wybieranym w czasie kompilacji (polityka, bez wywołań wirtualnych).
+// Backend dostarcza:
+//   begin(nowMs)                 – start sprzętu / kalibracji
+//   poll(nowMs, F(TouchEvent))   – jeden takt; F wołane dla każdego zdarzenia
+//   pressed()                    – czy palec jest teraz na ekranie
+// Backendy: ResistiveTouch (RES_*, gesty programowe) i Cst820Touch (gesty z układu).
+template <typename Backend>
+class TouchInput : public Backend
+{
+public:
+    using Backend::Backend;
+
+    template <typename F>
+    void poll(uint32_t nowMs, F onEvent)
+    {
+        Backend::poll(nowMs, [&](const TouchEvent &ev) {
+            _events++;
+            onEvent(ev);
+        });
+    }
+
+    uint32_t events() const { return _events; }
+
+private:
+    uint32_t _events = 0;
+};
+
+#endif
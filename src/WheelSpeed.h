@@ -0,0 +1,82 @@
+#ifndef _WHEEL_SPEED_H
+#define _WHEEL_SPEED_H
+
+#include <stdint.h>
+#include "PulseCapture.h"
+
+// Prędkość koła z czujnika Halla – ten sam mechanizm przechwytywania zboczy co RPM
+// (PulseCapture), prędkość z okresu między magnesami. Czas podaje wołający.
+template <uint16_t Capacity = 32>
+class WheelSpeed
+{
+public:
+    static constexpr uint16_t MIN_SPEED_X10 = 20; // poniżej 2 km/h uznajemy postój
+
+    WheelSpeed(uint32_t debounceUs, uint16_t circumferenceMm, uint8_t magnets)
+        : _capture(debounceUs),
+          _umPerPulse((uint32_t)circumferenceMm * 1000 / (magnets ? magnets : 1)),
+          _timeoutUs(_umPerPulse * 36 / MIN_SPEED_X10)
+    {
+    }
+
+    // Kontekst przerwania
+    inline __attribute__((always_inline)) void onEdge(uint32_t nowUs) { _capture.onEdge(nowUs); }
+
+    // Kontekst pętli: przetwórz zaległe zbocza; onPulse(edgeUs) dostaje każde z nich
+    template <typename F>
+    uint32_t poll(F onPulse)
+    {
+        uint32_t n = 0;
+        uint32_t edgeUs;
+        while (_capture.pop(edgeUs))
+        {
+            if (_hasEdge)
+            {
+                uint32_t periodUs = edgeUs - _lastEdgeUs;
+                // Po postoju pierwszy okres jest bezwartościowy – tylko wznawia pomiar
+                _periodUs = periodUs <= _timeoutUs ? periodUs : 0;
+            }
+            _hasEdge = true;
+            _lastEdgeUs = edgeUs;
+            _pulses++;
+            onPulse(edgeUs);
+            n++;
+        }
+        return n;
+    }
+
+    uint32_t poll()
+    {
+        return poll([](uint32_t) {});
+    }
+
+    // Prędkość [0.1 km/h] w chwili nowUs; bez impulsu dłużej niż okres – ograniczona z góry
+    uint16_t speedX10At(uint32_t nowUs) const
+    {
+        if (_periodUs == 0) return 0;
+        uint32_t sinceUs = nowUs - _lastEdgeUs;
+        if (sinceUs > _timeoutUs) return 0;
+        uint32_t periodUs = sinceUs > _periodUs ? sinceUs : _periodUs;
+        // 1 um/us = 3.6 km/h => [0.1 km/h] = um * 36 / us
+        return (uint16_t)((uint64_t)_umPerPulse * 36 / periodUs);
+    }
+
+    uint16_t kmhAt(uint32_t nowUs) const { return (speedX10At(nowUs) + 5) / 10; }
+
+    // Dystans narastający od startu [mm]
+    uint64_t distanceMm() const { return (uint64_t)_pulses * _umPerPulse / 1000; }
+    uint32_t umPerPulse() const { return _umPerPulse; }
+    uint32_t lastEdgeUs() const { return _lastEdgeUs; }
+    uint32_t rejected() const { return _capture.rejected(); }
+
+private:
+    PulseCapture<Capacity> _capture;
+    const uint32_t _umPerPulse;
+    const uint32_t _timeoutUs;
+    uint32_t _lastEdgeUs = 0;
+    uint32_t _periodUs = 0;
+    uint32_t _pulses = 0;
+    bool _hasEdge = false;
+};
+
+#endif
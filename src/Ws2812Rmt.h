@@ -0,0 +1,85 @@
+#ifndef _WS2812_RMT_H
+#define _WS2812_RMT_H
+
+#include <stdint.h>
+#include <esp_attr.h>
+#include <driver/rmt.h>
+
+// Sterownik WS2812 na peryferium RMT (IDF 4.4, sterownik "legacy").
+// Klasyczny ESP32 nie ma DMA dla RMT – bajty GRB na impulsy tłumaczy translator
+// wołany z przerwania RMT, który dolewa kolejne porcje do pamięci kanału
+// (ping-pong). CPU nie generuje bitów, a show() nie czeka na koniec transmisji.
+template <uint8_t MaxLeds>
+class Ws2812Rmt
+{
+public:
+    // Zegar RMT: APB 80 MHz / 2 = 25 ns na tick
+    static constexpr uint8_t CLK_DIV = 2;
+    static constexpr uint16_t T0H = 16; // 0.40 us
+    static constexpr uint16_t T0L = 34; // 0.85 us
+    static constexpr uint16_t T1H = 32; // 0.80 us
+    static constexpr uint16_t T1L = 18; // 0.45 us
+
+    Ws2812Rmt(uint8_t pin, rmt_channel_t channel) : _pin(pin), _channel(channel) {}
+
+    bool begin()
+    {
+        rmt_config_t cfg = RMT_DEFAULT_CONFIG_TX((gpio_num_t)_pin, _channel);
+        cfg.clk_div = CLK_DIV;
+        cfg.mem_block_num = 1;
+        if (rmt_config(&cfg) != ESP_OK) return false;
+        if (rmt_driver_install(_channel, 0, 0) != ESP_OK) return false;
+        _ready = rmt_translator_init(_channel, translate) == ESP_OK;
+        return _ready;
+    }
+
+    // Wysyła klatkę GRB (3 bajty na diodę). Zwraca false, gdy poprzednia jeszcze trwa –
+    // klatka jest wtedy pomijana, następna przyjdzie w kolejnym takcie.
+    bool show(const uint8_t *grb, uint16_t bytes)
+    {
+        if (!_ready) return false;
+        if (rmt_wait_tx_done(_channel, 0) != ESP_OK)
+        {
+            _skipped++;
+            return false;
+        }
+        // Bufor musi przeżyć transmisję – kopia po stronie sterownika
+        if (bytes > sizeof(_frame)) bytes = sizeof(_frame);
+        for (uint16_t i = 0; i < bytes; i++) _frame[i] = grb[i];
+        return rmt_write_sample(_channel, _frame, bytes, false) == ESP_OK;
+    }
+
+    uint32_t skipped() const { return _skipped; }
+
+private:
+    static void IRAM_ATTR translate(const void *src, rmt_item32_t *dest, size_t srcSize,
+                                    size_t wantedNum, size_t *translatedSize, size_t *itemNum)
+    {
+        if (src == nullptr || dest == nullptr)
+        {
+            *translatedSize = 0;
+            *itemNum = 0;
+            return;
+        }
+        const rmt_item32_t bit0 = {{{T0H, 1, T0L, 0}}};
+        const rmt_item32_t bit1 = {{{T1H, 1, T1L, 0}}};
+        const uint8_t *p = (const uint8_t *)src;
+        size_t size = 0, num = 0;
+        while (size < srcSize && num + 8 <= wantedNum)
+        {
+            for (uint8_t b = 0; b < 8; b++)
+                dest[num++].val = (p[size] & (0x80 >> b)) ? bit1.val : bit0.val;
+            size++;
+        }
+        *translatedSize = size;
+        *itemNum = num;
+    }
+
+    const uint8_t _pin;
+    const rmt_channel_t _channel;
+    bool _ready = false;
+    uint32_t _skipped = 0;
+    uint8_t _frame[3 * MaxLeds];
+};
+
+#endif
@@ -7,6 +7,30 @@
 #include <TFT_eSPI.h>
 #include <Wire.h>
 #include <FS.h>
+#include <Preferences.h>
+#include "EngineProfile.h"
+#include "RpmAcquisition.h"
+#include "WheelSpeed.h"
+#include "LaunchTimer.h"
+#include "LatencyStats.h"
+#include "Seqlock.h"
+#include "GearInput.h"
+#include "GearFilter.h"
+#include "GearSchedule.h"
+#include "GearEstimator.h"
+#include "ShiftLight.h"
+#include "LedBar.h"
+#include "Ws2812Rmt.h"
+#include "PinArbiter.h"
+#include "TouchFrontEnd.h"
+#include "TouchInput.h"
+#include "ResistiveTouch.h"
+#include "Cst820Touch.h"
+#include "SpscRing.h"
+#include <driver/adc.h>
+#include <esp_timer.h>
+#include <soc/gpio_reg.h>
+#include <atomic>
 // Możemy też użyć JPG; na razie używamy XBM i BMP z SPIFFS
 // Nowocześniejszy UI z gradientowym paskiem RPM, znacznikami oraz inną czcionką
 // GFX FreeFonts są opcjonalne (-DLOAD_GFXFF=1). Dodatkowo obsłużymy Smooth Font z plików .vlw.
@@ -32,11 +56,6 @@
 // Kluczowa zmiana: jawne wymiary panelu w konstruktorze
 TFT_eSPI tft = TFT_eSPI(320, 240);
 
-// Dane licznika (testowo symulowane). Docelowo możesz podmienić na realne pomiary
-static uint16_t currentRpm = 1200;   // 0..16000
-static uint16_t currentSpeed = 0;    // km/h
-static int8_t currentGear = 0;       // 0 = luz, 1..6
-
 // Skala RPM
 static const uint16_t RPM_MAX = 16000;
 static const uint8_t  RPM_TICKS = 17; // co 1000 rpm (0..16k)
@@ -54,31 +73,140 @@ static bool smoothFontsReady = false;
 static const char* FONT_SPEED_VLW = "/Final-Frontier48.vlw"; // duża czcionka prędkości i biegu
 static const char* FONT_LABEL_VLW = "/Final-Frontier24.vlw"; // etykiety
 
-// LED sygnalizacyjny – użyjemy kanału B z RGB (IO16), aktywnie niski
+// LED sygnalizacyjny – użyjemy kanału B z RGB (IO16), aktywnie niski; jasność z LEDC (PWM)
 #define LED_B_PIN 16
-static inline void ledBlue(bool on) { digitalWrite(LED_B_PIN, on ? LOW : HIGH); }
+static const uint8_t SHIFT_LED_CHANNEL = 0;
+static const uint32_t SHIFT_LED_PWM_HZ = 5000;
+static const uint8_t SHIFT_LED_PWM_BITS = 8;
+static inline void ledBlueDuty(uint8_t duty) { ledcWrite(SHIFT_LED_CHANNEL, 255 - duty); }
+
+// Listwa LED WS2812 (RMT); IO22 wolne na złączu rozszerzeń. LED_BAR_LEDS=0 wyłącza listwę.
+#ifndef LED_BAR_PIN
+#define LED_BAR_PIN 22
+#endif
+#ifndef LED_BAR_LEDS
+#define LED_BAR_LEDS 8
+#endif
 
 // Wejścia: RPM i biegi
 // RPM – wejście impulsów z cewki zapłonowej
+#ifndef PIN_RPM
 #define PIN_RPM     21
+#endif
 // Czujniki biegów (aktywnie niskie: zwierają do masy)
+#ifndef PIN_1_BIEG
 #define PIN_1_BIEG  32
+#endif
 #define PIN_N_BIEG  26
+#ifndef PIN_2_BIEG
 #define PIN_2_BIEG  25
+#endif
 #define PIN_3_BIEG  5
 #define PIN_4_BIEG  4
 #define PIN_5_BIEG  17
+// Kolejność N, 1..5 – maski rejestrów i tablica dekodująca liczone przez kompilator
+typedef GearInput<PIN_N_BIEG, PIN_1_BIEG, PIN_2_BIEG, PIN_3_BIEG, PIN_4_BIEG, PIN_5_BIEG> GearPins;
 
-volatile uint32_t rpmPulseCount = 0;
-volatile uint32_t rpmLastIrqMs = 0;
-static const uint32_t RPM_IRQ_DEBOUNCE_MS = 2; // filtr zakłóceń z cewki
+// Prędkość – czujnik Halla na kole (IO35: tylko wejście, bez wewn. pull-upu – moduł Halla
+// z własnym rezystorem podciągającym albo zewnętrzne 10k do 3V3)
+#define PIN_HALL    35
+#ifndef WHEEL_CIRCUMFERENCE_MM
+#define WHEEL_CIRCUMFERENCE_MM 1700 // obwód koła [mm] – nadpisz flagą builda
+#endif
+#ifndef WHEEL_MAGNETS
+#define WHEEL_MAGNETS 1             // magnesy na obrót koła
+#endif
 
-static void IRAM_ATTR rpmIsr() {
-  uint32_t now = millis();
-  if (now - rpmLastIrqMs >= RPM_IRQ_DEBOUNCE_MS) {
-    rpmPulseCount++;
-    rpmLastIrqMs = now;
+static const uint32_t RPM_IRQ_DEBOUNCE_US = 2000;  // filtr zakłóceń z cewki
+static const uint32_t HALL_IRQ_DEBOUNCE_US = 1000; // filtr drgań czujnika Halla
+// ISR zapisuje znaczniki czasu zboczy, pętla główna karmi nimi filtr alfa-beta
+// (ten sam kod uruchamia host-owy tools/replay)
+static RpmAcquisition<ActiveEngine> rpmAcq(RPM_IRQ_DEBOUNCE_US);
+static WheelSpeed<> wheel(HALL_IRQ_DEBOUNCE_US, WHEEL_CIRCUMFERENCE_MM, WHEEL_MAGNETS);
+static LaunchTimer launchTimer(wheel.umPerPulse());
+
+// Wspólny ISR przechwytywania: znacznik czasu zbocza trafia do odbiornika podanego jako arg
+template <typename Sink>
+static void IRAM_ATTR captureIsr(void* arg) {
+  static_cast<Sink*>(arg)->onEdge(micros());
+}
+
+template <typename Sink>
+static void attachCapture(uint8_t pin, uint8_t pinModeFlags, Sink& sink) {
+  pinMode(pin, pinModeFlags);
+  attachInterruptArg(digitalPinToInterrupt(pin), captureIsr<Sink>, &sink, FALLING);
+}
+
+// Opóźnienie impuls -> piksel: każda wartość RPM niesie znacznik czasu najnowszego
+// zbocza, z którego powstała; mierzymy wiek tego zbocza na kolejnych etapach.
+enum LatencyStage { LAT_RPM, LAT_SHIFT_LED, LAT_DRAW, LAT_STAGES };
+static const char* const LATENCY_STAGE_NAMES[LAT_STAGES] = { "rpm", "led", "draw" };
+// Każdy etap zapisuje tylko jedno zadanie; raport z loop() jest diagnostyczny
+// i toleruje zgubienie pojedynczej próbki przy reset().
+static LatencyStats<> latencyStats[LAT_STAGES];
+// Pomiar i raport [LAT] tylko w buildzie diagnostycznym (env esp32dev_debug)
+#ifndef LATENCY_DEBUG
+#define LATENCY_DEBUG 0
+#endif
+
+// Jedyne źródło danych licznika: zadanie czujników (rdzeń 0) publikuje, rysowanie
+// (rdzeń 1) czyta spójną kopię. Publikacja tylko przy zmianie widocznych pól,
+// więc wersja migawki mówi rysowaniu, czy w ogóle jest co odświeżać.
+struct Telemetry {
+  uint16_t rpm;         // 0..RPM_LIMIT
+  uint32_t rpmEdgeUs;   // znacznik zbocza, z którego powstało rpm
+  bool rpmTagged;       // czy rpm pochodzi ze świeżego impulsu
+  uint16_t speed;       // km/h
+  int8_t gear;          // 0 = luz, 1..6
+  uint8_t gearConfidence; // 0..100; 100 = potwierdzony czujnikiem, mniej = z przełożenia
+  // Liczniki całkowite, na km/h tylko przy wyświetlaniu – float co 20 ms gubi przyrosty
+  // przy dużych sumach (motogodziny stają ok. 128 h)
+  uint64_t odomMm;      // całkowity przebieg [mm]
+  uint64_t tripMm;      // przebieg dzienny [mm]
+  uint64_t motoMs;      // czas pracy silnika [ms]
+  uint32_t missedPulses;
+  uint32_t noisePulses;
+  uint32_t gearFaults;  // niefizyczne kombinacje/przejścia czujników biegu
+  LaunchTimer launch;
+};
+static Seqlock<Telemetry> telemetry;
+
+static const uint32_t MM_PER_TENTH_KM = 100000;
+static const uint32_t MS_PER_TENTH_H = 360000;
+
+static bool launchVisiblyChanged(const LaunchTimer& a, const LaunchTimer& b) {
+  const LaunchTimer::Result& ra = a.current();
+  const LaunchTimer::Result& rb = b.current();
+  return a.state() != b.state() || a.runs() != b.runs() ||
+         ra.t50Us != rb.t50Us || ra.t100Us != rb.t100Us || ra.t60mUs != rb.t60mUs;
+}
+
+// Czy zmieniło się coś, co widać na ekranie (liczniki w rozdzielczości wyświetlania)
+static bool telemetryVisiblyChanged(const Telemetry& a, const Telemetry& b) {
+  return a.rpm != b.rpm || a.speed != b.speed || a.gear != b.gear ||
+         a.gearConfidence / 10 != b.gearConfidence / 10 ||
+         a.odomMm / MM_PER_TENTH_KM != b.odomMm / MM_PER_TENTH_KM ||
+         a.tripMm / MM_PER_TENTH_KM != b.tripMm / MM_PER_TENTH_KM ||
+         a.motoMs / MS_PER_TENTH_H != b.motoMs / MS_PER_TENTH_H ||
+         a.missedPulses != b.missedPulses || a.noisePulses != b.noisePulses ||
+         a.gearFaults != b.gearFaults || launchVisiblyChanged(a.launch, b.launch);
+}
+
+static inline void latencyMark(LatencyStage stage, const Telemetry& t) {
+  if (LATENCY_DEBUG && t.rpmTagged) latencyStats[stage].record(micros() - t.rpmEdgeUs);
+}
+
+static void latencyReport() {
+  if (!LATENCY_DEBUG) return;
+  if (latencyStats[LAT_RPM].count() == 0) return;
+  Serial.print("[LAT]");
+  for (uint8_t i = 0; i < LAT_STAGES; i++) {
+    Serial.printf(" %s p50=%luus p99=%luus n=%lu", LATENCY_STAGE_NAMES[i],
+                  (unsigned long)latencyStats[i].percentileUs(50), (unsigned long)latencyStats[i].percentileUs(99),
+                  (unsigned long)latencyStats[i].count());
+    latencyStats[i].reset();
   }
+  Serial.println();
 }
 
 // --------------------------- Splash screen (XBM logo + progress) ---------------------------
@@ -187,27 +315,45 @@ static void showSplashScreen() {
 #define RES_XM 25
 #define RES_YM 26
 
-// Dolny panel: ODOMETER/TRIP/MOTO HOURS + logika potrójnego tapnięcia
-enum BottomMode { MODE_ODOM, MODE_TRIP, MODE_HOURS };
+// Panel dotykowy wybierany przy kompilacji: domyślnie rezystancyjny (RES_*),
+// -DTOUCH_PANEL_CST820=1 – pojemnościowy CST820 na I2C. Ten wariant zajmuje IO33/IO32 (I2C),
+// IO25 (RST) i IO21 (INT), więc PIN_RPM, PIN_1_BIEG i PIN_2_BIEG trzeba przenieść flagami builda
+// (gotowe przeniesienie: [env:esp32dev_cst820] w platformio.ini).
+#ifndef TOUCH_PANEL_CST820
+#define TOUCH_PANEL_CST820 0
+#endif
+#if TOUCH_PANEL_CST820
+#define CST_SDA 33
+#define CST_SCL 32
+#define CST_RST 25
+#define CST_INT 21
+static_assert(PIN_RPM != CST_INT && PIN_RPM != CST_SDA && PIN_RPM != CST_SCL && PIN_RPM != CST_RST,
+              "CST820: przenies PIN_RPM (-DPIN_RPM=...)");
+static_assert(PIN_1_BIEG != CST_SDA && PIN_1_BIEG != CST_SCL && PIN_1_BIEG != CST_RST && PIN_1_BIEG != CST_INT &&
+              PIN_2_BIEG != CST_SDA && PIN_2_BIEG != CST_SCL && PIN_2_BIEG != CST_RST && PIN_2_BIEG != CST_INT,
+              "CST820: przenies PIN_1_BIEG / PIN_2_BIEG");
+#endif
+
+// Dolny panel: ODOMETER/TRIP/MOTO HOURS/DIAGNOSTYKA + logika potrójnego tapnięcia
+enum BottomMode { MODE_ODOM, MODE_TRIP, MODE_HOURS, MODE_DIAG, MODE_COUNT };
 static BottomMode bottomMode = MODE_ODOM;
-static float odomKm = 0.0f;   // całkowity przebieg [km]
-static float tripKm = 0.0f;   // przebieg dzienny [km]
-static float motoHours = 0.0f;// motogodziny [h]
-static uint32_t lastIntegrateMs = 0;
-// Single-tap switch (debounce) + filtry i autokalibracja
-static uint32_t lastSwitchMs = 0;
-static const uint32_t TOUCH_SWITCH_DEBOUNCE_MS = 300;
-static int touchEmaY = 0, touchEmaX = 0;
-static bool isPressed = false;
-static bool touchCalibrated = false;
-static uint32_t touchCalibStartMs = 0;
-static const uint32_t TOUCH_CALIB_MS = 1200;
-static int baseY = 0, baseX = 0;
-static int thrPressY = 0, thrReleaseY = 0;
-static int deltaMarginX = 250;
-static const bool TOUCH_DEBUG = true;
-
-static void drawBottomPanel();
+// Ekrany: licznik albo pomiar przyspieszenia (tap po DIAG przechodzi na LAUNCH)
+enum Screen { SCREEN_DASH, SCREEN_LAUNCH };
+static Screen screen = SCREEN_DASH;
+// Log gestów i surowych odczytów dotyku z zadania czujników (rdzeń 0) – tylko w buildzie diagnostycznym
+#ifndef TOUCH_DEBUG
+#define TOUCH_DEBUG 0
+#endif
+// Ślad "[TRACE] t_ms pressed x y" dla tools/replay/gesture_replay (panel rezystancyjny)
+static const bool TOUCH_TRACE = false;
+
+static void drawBottomPanel(bool force = false);
+static void drawLaunchScreen(bool full);
+
+// Kopia migawki używana przez funkcje rysujące (tylko zadanie rysowania)
+static Telemetry view = {};
+// Zdarzenia dotyku z zadania czujników, obsługiwane przez zadanie rysowania
+static SpscRing<TouchEvent, 8> gestureQueue;
 
 static void drawLabels() {
   // Czyścimy dolny pasek etykiet i rysujemy tylko podpis dla biegu
@@ -218,7 +364,7 @@ static void drawLabels() {
     tft.setFreeFont(&FreeSansBold12pt7b);
   #endif
   tft.drawString("BIEG", AREA_GEAR.x, AREA_GEAR.y - 8);
-  drawBottomPanel();
+  drawBottomPanel(true);
 }
 
 static void drawRpmTrack() {
@@ -246,7 +392,7 @@ static void drawRpmTrack() {
   for (uint8_t t = 0; t < RPM_TICKS; ++t) {
     int x = x0 + (int)((t * 1000.0f / RPM_MAX) * AREA_RPM.w);
     int h = (t % 2 == 0) ? AREA_RPM.h : AREA_RPM.h * 3 / 4;
-    uint16_t c = (t >= 14) ? TFT_RED : TFT_BLACK; // czerwone w czerwonej strefie
+    uint16_t c = (t * 1000U >= ActiveEngine::REDLINE_RPM) ? TFT_RED : TFT_BLACK; // czerwone w czerwonej strefie
     tft.drawFastVLine(x, AREA_RPM.y + (AREA_RPM.h - h) / 2, h, c);
   }
 }
@@ -299,15 +445,19 @@ static void updateSpeed(uint16_t kmh) {
   #endif
   tft.setTextColor(TFT_CYAN, TFT_BLACK);
   tft.drawString("km/h", AREA_SPEED.x + AREA_SPEED.w / 2, AREA_SPEED.y + AREA_SPEED.h - 8);
-  drawBottomPanel();
 }
 
-static void updateGear(int8_t gear) {
+static void updateGear(int8_t gear, uint8_t confidence) {
   // Czyść obszar biegu
   tft.fillRect(AREA_GEAR.x, AREA_GEAR.y, AREA_GEAR.w, AREA_GEAR.h, TFT_BLACK);
   tft.drawRoundRect(AREA_GEAR.x, AREA_GEAR.y, AREA_GEAR.w, AREA_GEAR.h, 8, TFT_DARKGREY);
+  // Pasek pewności u dołu ramki; bieg z przełożenia (nie z czujnika) na żółto
+  bool inferred = confidence < 100;
+  int barW = (AREA_GEAR.w - 16) * confidence / 100;
+  uint16_t barCol = confidence >= 80 ? TFT_GREEN : (confidence >= 50 ? TFT_YELLOW : TFT_RED);
+  if (barW > 0) tft.fillRect(AREA_GEAR.x + 8, AREA_GEAR.y + AREA_GEAR.h - 8, barW, 3, barCol);
   tft.setTextDatum(MC_DATUM);
-  tft.setTextColor(gear == 0 ? TFT_GREEN : TFT_WHITE, TFT_BLACK);
+  tft.setTextColor(inferred ? TFT_YELLOW : (gear == 0 ? TFT_GREEN : TFT_WHITE), TFT_BLACK);
   const char* g = "N";
   char num[2] = {0};
   if (gear == 0) {
@@ -327,7 +477,653 @@ static void updateGear(int8_t gear) {
       tft.drawString(g, AREA_GEAR.x + AREA_GEAR.w / 2, AREA_GEAR.y + AREA_GEAR.h / 2 + 6, 8);
     #endif
   }
-  drawBottomPanel();
+}
+
+// ------------------------------ Zadania FreeRTOS ------------------------------
+// Rdzeń 0: akwizycja (RPM, Hall, biegi, dotyk) i LED zmiany biegu – wolny od TFT.
+// Rdzeń 1: rysowanie. Dane płyną tylko przez migawkę telemetry (Seqlock).
+static const uint32_t SENSOR_PERIOD_MS = 1;    // obsługa kolejek zboczy
+static const uint32_t TELEMETRY_PERIOD_MS = 20; // publikacja migawki
+static const uint32_t GEAR_SAMPLE_MS = 5;       // próbka pinów biegu do filtra (po zboczu)
+static const uint32_t GEAR_WINDOW_MS = 100;     // tyle próbkujemy po ostatnim zboczu pinu biegu
+static const uint32_t GEAR_FALLBACK_MS = 500;   // rzadka próbka kontrolna bez zboczy
+static const uint32_t SHIFT_LIGHT_PERIOD_US = 2000; // takt lampki zmiany biegu (esp_timer)
+#if TOUCH_PANEL_CST820
+static const uint32_t TOUCH_PERIOD_MS = 5;      // tylko opróżnienie kolejki sterownika
+#else
+static const uint32_t TOUCH_PERIOD_MS = 25;
+#endif
+static const uint32_t RENDER_PERIOD_MS = 50;    // sprawdzenie wersji migawki
+static const uint32_t FLASH_PERIOD_MS = 200;    // takt migania ekranu przy odcince
+static const uint32_t TASK_REPORT_MS = 5000;
+// Raport [TASK] (obciążenie, stos, koszt arbitra) tylko w buildzie diagnostycznym
+#ifndef TASK_REPORT
+#define TASK_REPORT 0
+#endif
+
+struct TaskStats {
+  const char* name;
+  TaskHandle_t handle;
+  uint32_t busyUs;      // narastający czas pracy (pisze tylko właściciel)
+  uint32_t lastBusyUs;  // stan z poprzedniego raportu
+};
+static TaskStats sensorStats = { "sensor", nullptr, 0, 0 };
+static TaskStats renderStats = { "render", nullptr, 0, 0 };
+
+static void pollTouch();
+
+// Zbocza na pinach biegu: ISR tylko zaznacza zdarzenie, próbkowanie i filtr
+// działają w zadaniu czujników. Bez zmiany biegu nic się nie dzieje.
+static std::atomic<bool> gearEdgePending{false};
+static volatile bool gearIrqMuted = false;  // piny współdzielone z dotykiem w trakcie pomiaru
+static volatile uint32_t gearIrqCount = 0;
+
+static void IRAM_ATTR gearEdgeIsr() {
+  if (gearIrqMuted) return;
+  gearIrqCount++;
+  gearEdgePending.store(true, std::memory_order_relaxed);
+}
+
+static void attachGearInterrupts() {
+  for (uint8_t i = 0; i < GearPins::COUNT; i++) {
+    attachInterrupt(digitalPinToInterrupt(GearPins::PINS[i]), gearEdgeIsr, CHANGE);
+  }
+}
+
+// Piny 32/25/26 to jednocześnie RES_YP/RES_XM/RES_YM dotyku i biegi 1/2/N.
+// Trybem pinów zarządza wyłącznie arbiter: okno dotyku, potem INPUT_PULLUP
+// i SHARED_PIN_SETTLE_US ustalania (podciąganie przez ~45k na kablu) przed próbką biegu.
+static const uint32_t SHARED_PIN_SETTLE_US = 200;
+
+#if !TOUCH_PANEL_CST820
+// Dotyk z ADC1 w trybie ciągłym (na klasycznym ESP32: I2S0 + DMA): seria próbek jednego
+// kanału bez udziału CPU, zadanie czeka na bufor DMA. RES_YP=IO32 -> ADC1_CH4, RES_XP=IO33 -> ADC1_CH5.
+// Ramka DMA (przerwanie) = dokładnie jedna seria, więc odczyt wraca zaraz po ostatniej
+// próbce osi zamiast czekać na dłuższą ramkę; timeout z czasu ramki + 1 tick zapasu.
+static const uint32_t TOUCH_ADC_HZ = 40000;   // 16 próbek = 0.4 ms na oś
+static const uint8_t TOUCH_ADC_WARMUP = 2;    // pierwsze konwersje po starcie odrzucamy
+static const uint8_t TOUCH_ADC_SAMPLES = 16;  // = TouchBurstConfig::samples
+static const uint32_t TOUCH_ADC_FRAME_CONV = TOUCH_ADC_WARMUP + TOUCH_ADC_SAMPLES;
+static const uint32_t TOUCH_ADC_FRAME_BYTES = TOUCH_ADC_FRAME_CONV * sizeof(adc_digi_output_data_t);
+static const uint32_t TOUCH_ADC_TIMEOUT_MS = (TOUCH_ADC_FRAME_CONV * 1000 + TOUCH_ADC_HZ - 1) / TOUCH_ADC_HZ + 1;
+static_assert(TouchBurstConfig{}.samples == TOUCH_ADC_SAMPLES, "TOUCH_ADC_SAMPLES: inna dlugosc serii niz w TouchFrontEnd");
+static_assert(TOUCH_ADC_FRAME_BYTES % 4 == 0, "TOUCH_ADC_FRAME_BYTES: ramka DMA musi byc wielokrotnoscia 4 B");
+static bool touchAdcReady = false;
+static uint32_t touchAdcShort = 0;            // serie z brakującymi próbkami
+
+static void touchAdcInit() {
+  adc_digi_init_config_t init = {};
+  init.max_store_buf_size = 256;
+  init.conv_num_each_intr = TOUCH_ADC_FRAME_BYTES;
+  init.adc1_chan_mask = BIT(ADC1_CHANNEL_4) | BIT(ADC1_CHANNEL_5);
+  init.adc2_chan_mask = 0;
+  touchAdcReady = adc_digi_initialize(&init) == ESP_OK;
+  if (!touchAdcReady) Serial.println("[TOUCH] ADC DMA niedostepny");
+}
+
+static uint8_t touchAdcBurst(uint8_t pin, uint16_t* out, uint8_t n) {
+  if (!touchAdcReady) return 0;
+  adc1_channel_t ch = (pin == RES_YP) ? ADC1_CHANNEL_4 : ADC1_CHANNEL_5;
+  // Pad z powrotem do ADC (pinMode przełącza go na cyfrowe GPIO)
+  adc1_config_channel_atten(ch, ADC_ATTEN_DB_11);
+  adc_digi_pattern_config_t pattern = {};
+  pattern.atten = ADC_ATTEN_DB_11;
+  pattern.channel = ch;
+  pattern.unit = 0;
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+  adc_digi_configuration_t cfg = {};
+  cfg.conv_limit_en = 1;
+  cfg.conv_limit_num = 250;
+  cfg.pattern_num = 1;
+  cfg.adc_pattern = &pattern;
+  cfg.sample_freq_hz = TOUCH_ADC_HZ;
+  cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+  adc_digi_controller_configure(&cfg);
+
+  uint8_t raw[TOUCH_ADC_FRAME_BYTES];
+  uint8_t got = 0, skip = TOUCH_ADC_WARMUP;
+  adc_digi_start();
+  while (got < n) {
+    uint32_t len = 0;
+    esp_err_t err = adc_digi_read_bytes(raw, sizeof(raw), &len, TOUCH_ADC_TIMEOUT_MS);
+    if (err == ESP_ERR_TIMEOUT) break;
+    for (uint32_t i = 0; i + 1 < len && got < n; i += 2) {
+      const adc_digi_output_data_t* d = (const adc_digi_output_data_t*)&raw[i];
+      if (d->type1.channel != ch) continue;
+      if (skip) { skip--; continue; }
+      out[got++] = d->type1.data;
+    }
+  }
+  adc_digi_stop();
+  // Konwersje po serii zostają w buforze pierścieniowym – bez opróżnienia kolejna oś
+  // (Z1 po X) dostałaby na start dane z poprzedniej fazy
+  uint32_t len = 0;
+  while (adc_digi_read_bytes(raw, sizeof(raw), &len, 0) == ESP_OK && len > 0) {}
+  if (got < n) touchAdcShort++;
+  return got;
+}
+#endif
+
+struct SharedPinHal {
+  uint32_t micros() const { return ::micros(); }
+  void muteGear(bool muted) { gearIrqMuted = muted; }
+  // Spoczynek: piny biegów z podciąganiem, RES_XP (tylko dotyk) jako wejście
+  void gearMode() {
+    pinMode(PIN_1_BIEG, INPUT_PULLUP);
+    pinMode(PIN_2_BIEG, INPUT_PULLUP);
+    pinMode(PIN_N_BIEG, INPUT_PULLUP);
+#if !TOUCH_PANEL_CST820
+    pinMode(RES_XP, INPUT);
+#endif
+  }
+#if !TOUCH_PANEL_CST820
+  // Funkcje pomiaru dotyku – dostępne tylko wewnątrz okna PinArbiter::touch()
+  void drive(uint8_t pin, bool high) { pinMode(pin, OUTPUT); digitalWrite(pin, high ? HIGH : LOW); }
+  void release(uint8_t pin) { pinMode(pin, INPUT); }
+  void delayUs(uint32_t us) { delayMicroseconds(us); }
+  uint8_t burst(uint8_t pin, uint16_t* out, uint8_t n) { return touchAdcBurst(pin, out, n); }
+#endif
+};
+static SharedPinHal sharedPinHal;
+static PinArbiter<SharedPinHal> pinArbiter(sharedPinHal, SHARED_PIN_SETTLE_US);
+
+// Jeden typ wejścia dotykowego dla UI – backend wybrany przy kompilacji
+#if TOUCH_PANEL_CST820
+static CST820 cst820(CST_SDA, CST_SCL, CST_RST, CST_INT);
+typedef TouchInput<Cst820Touch> Touch;
+static Touch touchInput(cst820);
+#else
+static TouchFrontEnd<RES_YP, RES_XP, RES_XM, RES_YM> touchFrontEnd;
+typedef TouchInput<ResistiveTouch<TouchFrontEnd<RES_YP, RES_XP, RES_XM, RES_YM>, PinArbiter<SharedPinHal>>> Touch;
+static Touch touchInput(touchFrontEnd, pinArbiter);
+
+// Kalibracja panelu w NVS: wczytana przy starcie (dotyk działa od razu), zapisywana po
+// pierwszej dobrej kalibracji i gdy dryf spoczynku urośnie. Zapis flash blokuje cache,
+// więc robi go loop() (niski priorytet) i najwyżej raz na TOUCH_CAL_SAVE_MIN_MS.
+static const char* TOUCH_CAL_NS = "touch";
+static const uint8_t TOUCH_CAL_VERSION = 1;
+static const uint32_t TOUCH_CAL_SAVE_MIN_MS = 60000;
+static const int TOUCH_CAL_SAVE_DELTA = 12;     // [LSB] dryf spoczynku wart zapisu
+static Seqlock<TouchCalibration> touchCalShared; // zadanie czujników -> loop()
+static TouchCalibration touchCalSaved = {};
+// Pisze setup()/loop(), czyta też zadanie czujników (log pierwszej kalibracji)
+static std::atomic<bool> touchCalStored{false};
+
+static bool loadTouchCalibration(TouchCalibration& cal) {
+  Preferences prefs;
+  if (!prefs.begin(TOUCH_CAL_NS, true)) return false;
+  bool ok = prefs.getUChar("ver", 0) == TOUCH_CAL_VERSION &&
+            prefs.getBytes("cal", &cal, sizeof(cal)) == sizeof(cal);
+  prefs.end();
+  return ok && Touch::validCalibration(cal);
+}
+
+static void saveTouchCalibration() {
+  static uint32_t lastSaveMs = 0;
+  static uint32_t lastVersion = 0;
+  TouchCalibration cal;
+  uint32_t version = touchCalShared.read(cal);
+  if (version == 0 || version == lastVersion) return;  // brak nowej kalibracji
+  if (touchCalStored.load(std::memory_order_relaxed)) {
+    int drift = abs(cal.baseX - touchCalSaved.baseX) + abs(cal.baseY - touchCalSaved.baseY);
+    if (drift < TOUCH_CAL_SAVE_DELTA || millis() - lastSaveMs < TOUCH_CAL_SAVE_MIN_MS) return;
+  }
+  Preferences prefs;
+  if (!prefs.begin(TOUCH_CAL_NS, false)) return;
+  bool ok = prefs.putBytes("cal", &cal, sizeof(cal)) == sizeof(cal) && prefs.putUChar("ver", TOUCH_CAL_VERSION);
+  prefs.end();
+  lastSaveMs = millis();
+  if (!ok) return;
+  lastVersion = version;
+  touchCalSaved = cal;
+  touchCalStored.store(true, std::memory_order_relaxed);
+  Serial.printf("[TOUCH] Calibration saved baseY=%d baseX=%d\n", cal.baseY, cal.baseX);
+}
+#endif
+
+// Zdarzenia dla zadania rysowania (bity powiadomienia)
+static const uint32_t RENDER_EVT_GEAR = 1UL << 0;
+
+static inline GearDecode sampleGearPins(uint8_t* code) {
+  // Jeden odczyt rejestrów wejść zamiast sześciu digitalRead; rejestr bez żadnego
+  // pinu biegu (maska z listy pinów = 0) w ogóle nie jest czytany
+  uint32_t inLo = GearPins::MASK_LO ? REG_READ(GPIO_IN_REG) : 0;
+  uint32_t inHi = GearPins::MASK_HI ? REG_READ(GPIO_IN1_REG) : 0;
+  *code = GearPins::code(inLo, inHi);
+  return GearPins::decode(*code);
+}
+
+// Filtr biegu: 4 próbki co GEAR_SAMPLE_MS na pin (20 ms na drgania styków),
+// 60 ms potwierdzenia, niefizyczny skok przyjmowany dopiero po 0.5 s
+static const uint8_t GEAR_INTEGRATE_SAMPLES = 4;
+static const uint32_t GEAR_CONFIRM_US = 60000;
+static const uint32_t GEAR_FORCE_US = 500000;
+static GearFilter gearFilter(GEAR_INTEGRATE_SAMPLES, GEAR_CONFIRM_US, GEAR_FORCE_US);
+
+static int8_t readGear(uint32_t nowUs) {
+  // Bieg – aktywny GND na wejściach (N=0, 1..5); surowy kod idzie przez filtr
+  uint8_t code;
+  sampleGearPins(&code);
+  uint32_t changes = gearFilter.changes();
+  uint32_t faults = gearFilter.faults();
+  int8_t gear = gearFilter.update(code, nowUs);
+  if (gearFilter.changes() != changes) {
+    Serial.printf("[GEAR] piny 0x%02x -> gear=%d\n", gearFilter.stableCode(), gear);
+  }
+  if (gearFilter.faults() != faults) {
+    Serial.printf("[GEAR] niefizyczny stan 0x%02x przy gear=%d (multi=%lu skok=%lu wymuszone=%lu)\n",
+                  gearFilter.stableCode(), gearFilter.gear(),
+                  (unsigned long)gearFilter.multiPin(), (unsigned long)gearFilter.implausible(),
+                  (unsigned long)gearFilter.forced());
+  }
+  return gear;
+}
+
+// Estymator przełożenia: uczy się na biegach z czujnika, zastępuje czujnik, gdy go brak,
+// gdy pewnie się z nim nie zgadza albo dla 6. biegu bez wejścia
+static GearEstimator<6> gearEstimator;
+static const uint8_t GEAR_INFER_CONFIDENCE = 50;     // minimum, by pokazać bieg bez czujnika
+static const uint8_t GEAR_OVERRIDE_CONFIDENCE = 85;  // minimum, by podważyć czujnik
+static const uint32_t GEAR_SENSOR_LOST_US = 300000;  // tyle bez aktywnego pinu = brak czujnika
+
+static void fuseGear(Telemetry& t, uint16_t speedX10, uint32_t nowUs) {
+  static uint32_t sensorSeenUs = 0;
+  static uint32_t disagreements = 0;
+  int8_t sensorGear = gearFilter.gear();
+  if (gearFilter.settled()) sensorSeenUs = nowUs;
+  bool sensorOk = sensorGear >= 0 && nowUs - sensorSeenUs < GEAR_SENSOR_LOST_US;
+
+  GearEstimator<6>::Estimate e = gearEstimator.estimate(t.rpm, speedX10);
+  if (sensorOk && gearFilter.settled() && sensorGear > 0 && e.gear > 0 && e.gear != sensorGear &&
+      e.confidence >= GEAR_OVERRIDE_CONFIDENCE) {
+    // Czujnik i przełożenie pewnie się różnią – wierzymy przełożeniu, nie uczymy się
+    if (t.gear != e.gear) {
+      disagreements++;
+      Serial.printf("[GEAR] czujnik=%d, przelozenie=%d (%u%%), rozbieznosci=%lu\n",
+                    sensorGear, e.gear, e.confidence, (unsigned long)disagreements);
+    }
+    t.gear = e.gear;
+    t.gearConfidence = e.confidence;
+    return;
+  }
+  if (sensorOk) {
+    if (gearFilter.settled()) {
+      bool wasLearned = gearEstimator.learned(sensorGear);
+      gearEstimator.learn(sensorGear, t.rpm, speedX10);
+      if (!wasLearned && gearEstimator.learned(sensorGear)) {
+        Serial.printf("[GEAR] nauczony bieg %d: %lu rpm/(km/h)\n", sensorGear,
+                      (unsigned long)(gearEstimator.ratioQ8Of(sensorGear) >> 8));
+      }
+    }
+    t.gear = sensorGear;
+    t.gearConfidence = 100;
+    return;
+  }
+  // Brak czujnika (albo bieg bez wejścia) – bieg z przełożenia, inaczej ostatni znany bez pewności
+  if (e.gear > 0 && e.confidence >= GEAR_INFER_CONFIDENCE) {
+    t.gear = e.gear;
+    t.gearConfidence = e.confidence;
+  } else {
+    t.gearConfidence = 0;
+  }
+}
+
+#if GEAR_BENCH
+// Mikrobenchmark (-DGEAR_BENCH=1): dawny odczyt 6x digitalRead + if/else vs rejestr + tablica
+static int8_t readGearLegacy() {
+  bool nLow = (digitalRead(PIN_N_BIEG) == LOW);
+  bool g1Low = (digitalRead(PIN_1_BIEG) == LOW);
+  bool g2Low = (digitalRead(PIN_2_BIEG) == LOW);
+  bool g3Low = (digitalRead(PIN_3_BIEG) == LOW);
+  bool g4Low = (digitalRead(PIN_4_BIEG) == LOW);
+  bool g5Low = (digitalRead(PIN_5_BIEG) == LOW);
+  if (nLow) return 0;
+  if (g1Low) return 1;
+  if (g2Low) return 2;
+  if (g3Low) return 3;
+  if (g4Low) return 4;
+  if (g5Low) return 5;
+  return -1;
+}
+
+static void benchGearRead() {
+  const uint32_t N = 10000;
+  volatile int8_t sink = 0;
+  uint8_t code;
+  uint32_t c0 = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N; i++) sink = readGearLegacy();
+  uint32_t c1 = ESP.getCycleCount();
+  for (uint32_t i = 0; i < N; i++) sink = sampleGearPins(&code).gear;
+  uint32_t c2 = ESP.getCycleCount();
+  (void)sink;
+  Serial.printf("[BENCH] gear read: digitalRead x6 = %lu cyc, rejestr+LUT = %lu cyc (masks lo=0x%08lx hi=0x%08lx)\n",
+                (unsigned long)((c1 - c0) / N), (unsigned long)((c2 - c1) / N),
+                (unsigned long)GearPins::MASK_LO, (unsigned long)GearPins::MASK_HI);
+}
+#endif
+
+// Lampka zmiany biegu: własny timer (esp_timer, zadanie o priorytecie 22), więc takt
+// migania i rampy PWM nie zależą od obciążenia rysowaniem ani od pętli czujników.
+// Zadanie czujników publikuje tylko dane wejściowe przez Seqlock.
+typedef ShiftLight<ActiveEngine> ActiveShiftLight;
+static ActiveShiftLight shiftLight;
+static Seqlock<ActiveShiftLight::Input> shiftInput;
+static esp_timer_handle_t shiftTimer = nullptr;
+
+#if LED_BAR_LEDS
+typedef LedBar<ActiveEngine, LED_BAR_LEDS> ActiveLedBar;
+static ActiveLedBar ledBar;
+static Ws2812Rmt<LED_BAR_LEDS> ledStrip(LED_BAR_PIN, RMT_CHANNEL_0);
+static const uint8_t LED_BAR_TICKS = 5;  // co 5 taktów lampki = 100 Hz
+#endif
+
+static void publishShiftInput(int8_t gear) {
+  uint32_t nowUs = micros();
+  ActiveShiftLight::Input in;
+  in.rpm = rpmAcq.rpmAt(nowUs, 0);
+  in.rateRpmPerSec = rpmAcq.tracker().rateRpmPerSec();
+  in.sampleUs = nowUs;
+  in.edgeUs = rpmAcq.tracker().lastEdgeUs();
+  in.gear = gear;
+  shiftInput.write(in);
+}
+
+static void shiftLightTick(void*) {
+  static ActiveShiftLight::Input in = {};
+  static uint8_t lastDuty = 0;
+  static ActiveShiftLight::Zone lastZone = ActiveShiftLight::ZONE_OFF;
+  static bool zonePending = false;
+  static uint32_t zoneEdgeUs = 0;
+  uint32_t version;
+  // Timer może przerwać pisarza na tym samym rdzeniu – przy nieudanym odczycie
+  // zostają poprzednie dane, kolejny takt za 2 ms. Odczyt do kopii roboczej:
+  // tryRead() mógł już nadpisać ją rozerwaną migawką
+  ActiveShiftLight::Input fresh;
+  if (shiftInput.tryRead(fresh, version)) in = fresh;
+  uint32_t nowUs = micros();
+#if LED_BAR_LEDS
+  // Listwa: ta sama migawka wejść, klatka wysyłana przez RMT bez udziału CPU
+  static uint8_t barTick = 0;
+  if (++barTick >= LED_BAR_TICKS) {
+    barTick = 0;
+    uint8_t frame[ActiveLedBar::FRAME_BYTES];
+    ledBar.render(in.rpm, in.gear, nowUs, frame);
+    ledStrip.show(frame, sizeof(frame));
+  }
+#endif
+  // Opóźnienie impuls -> LED: od zbocza, które zmieniło strefę progu, do pierwszej
+  // zmiany jasności po niej; przełączenia fazy migania nie są nową decyzją
+  ActiveShiftLight::Zone zone = shiftLight.zone(in, nowUs);
+  if (zone != lastZone) {
+    lastZone = zone;
+    zonePending = in.rpm > 0;
+    zoneEdgeUs = in.edgeUs;
+  }
+  uint8_t duty = shiftLight.duty(in, nowUs);
+  if (duty == lastDuty) return;
+  ledBlueDuty(duty);
+  lastDuty = duty;
+  // Jedyny pisarz tego etapu
+  if (LATENCY_DEBUG && zonePending) latencyStats[LAT_SHIFT_LED].record(micros() - zoneEdgeUs);
+  zonePending = false;
+}
+
+static void startShiftLight() {
+  ledcSetup(SHIFT_LED_CHANNEL, SHIFT_LED_PWM_HZ, SHIFT_LED_PWM_BITS);
+  ledcAttachPin(LED_B_PIN, SHIFT_LED_CHANNEL);
+  ledBlueDuty(0);
+#if LED_BAR_LEDS
+  if (!ledStrip.begin()) Serial.println("[LED] RMT listwy niedostepny");
+#endif
+  esp_timer_create_args_t args = {};
+  args.callback = shiftLightTick;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "shift";
+  esp_timer_create(&args, &shiftTimer);
+  esp_timer_start_periodic(shiftTimer, SHIFT_LIGHT_PERIOD_US);
+}
+
+static void sensorTask(void*) {
+  // Przerwania rejestrowane z tego zadania obsługuje rdzeń 0
+  attachCapture(PIN_RPM, INPUT_PULLUP, rpmAcq);
+  attachCapture(PIN_HALL, INPUT, wheel);
+  attachGearInterrupts();
+
+  Telemetry t = {};
+  Telemetry published = {};
+  uint32_t lastTouchPoll = 0;
+  GearSchedule gearSchedule(GEAR_SAMPLE_MS, GEAR_WINDOW_MS, GEAR_FALLBACK_MS);
+  uint32_t lastTelemetryMs = millis(); // start od teraz – pierwszy przyrost motogodzin bez czasu rozruchu
+  uint64_t lastDistanceMm = 0;
+  TickType_t lastWake = xTaskGetTickCount();
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SENSOR_PERIOD_MS));
+    uint32_t startUs = micros();
+
+    // Zbocza z cewki i Halla przetwarzamy na bieżąco; nowy pomiar RPM od razu do lampki
+    if (rpmAcq.poll()) publishShiftInput(t.gear);
+    wheel.poll([](uint32_t edgeUs) { launchTimer.onWheelEdge(edgeUs); });
+
+    uint32_t nowMs = millis();
+    // Bieg: próbki tylko po zboczu (do uspokojenia filtra) plus rzadka próbka kontrolna;
+    // gdy ta trafi na zmianę bez zbocza (zgubione przerwanie), busy() podtrzyma próbkowanie
+    // Zbocze = żądanie próbki u arbitra; po oknie dotyku (zbocza wyciszone) arbiter
+    // sam zgłasza żądanie, a do jego obsługi nie otworzy kolejnego okna dotyku
+    pinArbiter.service();
+    if (gearEdgePending.exchange(false, std::memory_order_relaxed)) pinArbiter.requestGear();
+    // Okno próbkowania odnawia tylko zbocze; próbka po oknie dotyku jest jednorazowa
+    // (gdy trafi na zmianę, dalsze próbki podtrzyma gearFilter.busy())
+    bool gearDue = gearSchedule.due(nowMs, pinArbiter.gearRequested(), pinArbiter.gearEdgeRequested(),
+                                    gearFilter.busy());
+    uint32_t changes = gearFilter.changes();
+    uint32_t nowUs = micros();
+    if (gearDue && pinArbiter.gear([nowUs] { readGear(nowUs); })) {
+      gearSchedule.sampled(nowMs);
+      t.gearFaults = gearFilter.faults();
+      if (gearFilter.changes() != changes) {
+        // Nowy bieg od razu do migawki i do rysowania – bez czekania na takt telemetrii
+        int8_t shownGear = t.gear;
+        fuseGear(t, wheel.speedX10At(nowUs), nowUs);
+        if (t.gear != shownGear) {
+          telemetry.write(t);
+          published = t;
+          if (renderStats.handle) xTaskNotify(renderStats.handle, RENDER_EVT_GEAR, eSetBits);
+        }
+      }
+    }
+
+    if (nowMs - lastTelemetryMs >= TELEMETRY_PERIOD_MS) {
+      // Rzeczywisty odstęp: spóźniony takt (np. długie okno dotyku) nie gubi czasu pracy
+      uint32_t elapsedMs = nowMs - lastTelemetryMs;
+      lastTelemetryMs = nowMs;
+      uint32_t nowUs = micros();
+      // RPM z filtra alfa-beta, przewidziane o PREDICT_MS do przodu (opóźnienie ekranu/LED)
+      t.rpm = rpmAcq.rpmAt(nowUs);
+      t.rpmEdgeUs = rpmAcq.tracker().lastEdgeUs();
+      t.rpmTagged = (t.rpm > 0);
+      latencyMark(LAT_RPM, t);
+      // Prędkość z okresu impulsów Halla (0 po przekroczeniu limitu czasu postoju)
+      uint16_t speedX10 = wheel.speedX10At(nowUs);
+      t.speed = wheel.kmhAt(nowUs);
+      launchTimer.update(nowUs, speedX10);
+      // Bieg: czujnik po filtrze, a gdy go brak lub się nie zgadza – z przełożenia
+      fuseGear(t, speedX10, nowUs);
+      // Przebieg z licznika impulsów koła – dokładniejszy niż całkowanie prędkości
+      uint64_t distMm = wheel.distanceMm();
+      uint64_t dMm = distMm - lastDistanceMm;
+      lastDistanceMm = distMm;
+      t.odomMm += dMm;
+      t.tripMm += dMm;
+      // Motogodziny: tylko gdy silnik pracuje
+      if (t.rpm > 0) t.motoMs += elapsedMs;
+      t.missedPulses = rpmAcq.missedPulses();
+      t.noisePulses = rpmAcq.noisePulses();
+      t.launch = launchTimer;
+      publishShiftInput(t.gear);
+
+      if (telemetryVisiblyChanged(t, published)) {
+        telemetry.write(t);
+        published = t;
+      }
+    }
+
+    // Dotyk tylko w oknie arbitra i nie wtedy, gdy czeka obowiązkowa próbka biegu
+    if (nowMs - lastTouchPoll > TOUCH_PERIOD_MS && !pinArbiter.gearRequested()) {
+      lastTouchPoll = nowMs;
+      pollTouch();
+    }
+
+    sensorStats.busyUs += micros() - startUs;
+  }
+}
+
+static void redrawDash() {
+  drawStaticUi();
+  updateSpeed(view.speed);
+  updateGear(view.gear, view.gearConfidence);
+  updateRpm(view.rpm);
+}
+
+// Kolejny / poprzedni widok w cyklu: ODO -> TRIP -> MOTO -> DIAG -> LAUNCH -> ODO
+static void stepView(bool forward) {
+  if (screen == SCREEN_LAUNCH) {
+    screen = SCREEN_DASH;
+    bottomMode = forward ? MODE_ODOM : (BottomMode)(MODE_COUNT - 1);
+    redrawDash();
+  } else if (forward ? bottomMode + 1 == MODE_COUNT : bottomMode == MODE_ODOM) {
+    screen = SCREEN_LAUNCH;
+    drawLaunchScreen(true);
+  } else {
+    bottomMode = (BottomMode)(forward ? bottomMode + 1 : bottomMode - 1);
+    drawBottomPanel();
+  }
+}
+
+// Kierunki przeciągnięć według surowych osi płytki (bez kalibracji ekranu)
+static void handleGestures() {
+  TouchEvent ev;
+  while (gestureQueue.pop(ev)) {
+    switch (ev.gesture) {
+      case GESTURE_TAP:
+      case GESTURE_SWIPE_LEFT:
+        stepView(true);
+        break;
+      case GESTURE_DOUBLE_TAP:
+      case GESTURE_SWIPE_RIGHT:
+        stepView(false);
+        break;
+      case GESTURE_SWIPE_UP:
+      case GESTURE_SWIPE_DOWN:
+        // Skrót między licznikiem a pomiarem przyspieszenia
+        if (screen == SCREEN_LAUNCH) {
+          screen = SCREEN_DASH;
+          redrawDash();
+        } else {
+          screen = SCREEN_LAUNCH;
+          drawLaunchScreen(true);
+        }
+        break;
+      case GESTURE_LONG_PRESS:
+        // Powrót do ekranu startowego
+        screen = SCREEN_DASH;
+        bottomMode = MODE_ODOM;
+        redrawDash();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+static void renderTask(void*) {
+  bool flashOn = false;         // stan klatki (czerwony/ekran UI)
+  bool wasFlashActive = false;  // czy poprzednio był aktywny alert
+  uint32_t lastVersion = telemetry.version();
+  uint32_t lastFlashMs = 0;
+  Telemetry drawn = view;       // co aktualnie jest na ekranie
+  bool changed = false;         // migawka odczytana, a pełny przebieg jeszcze jej nie narysował
+  const TickType_t period = pdMS_TO_TICKS(RENDER_PERIOD_MS);
+  TickType_t lastWake = xTaskGetTickCount();
+  for (;;) {
+    // Czekamy do kolejnego taktu albo do zdarzenia od zadania czujników
+    TickType_t sinceWake = xTaskGetTickCount() - lastWake;
+    uint32_t events = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &events, sinceWake < period ? period - sinceWake : 0);
+    uint32_t startUs = micros();
+
+    if (xTaskGetTickCount() - lastWake < period) {
+      // Zmiana biegu między taktami: tylko AREA_GEAR, reszta w zwykłym takcie
+      if ((events & RENDER_EVT_GEAR) && screen == SCREEN_DASH && !wasFlashActive) {
+        lastVersion = telemetry.read(view);
+        changed = true;
+        if (view.gear != drawn.gear || view.gearConfidence / 10 != drawn.gearConfidence / 10) {
+          updateGear(view.gear, view.gearConfidence);
+          drawn.gear = view.gear;
+          drawn.gearConfidence = view.gearConfidence;
+        }
+      }
+      renderStats.busyUs += micros() - startUs;
+      continue;
+    }
+    lastWake = xTaskGetTickCount();
+
+    // Kopia migawki tylko gdy wersja się zmieniła – inaczej klatka jest pomijana
+    if (telemetry.version() != lastVersion) {
+      lastVersion = telemetry.read(view);
+      changed = true;
+    }
+    handleGestures();
+
+    // Miganie całego ekranu przy wysokich RPM
+    const uint16_t THRESH = ActiveEngine::FLASH_RPM; // próg odcinki z profilu silnika
+    bool flashActive = (view.rpm >= THRESH) && screen == SCREEN_DASH;
+    uint32_t nowMs = millis();
+    if (screen == SCREEN_LAUNCH) {
+      drawLaunchScreen(false);
+    } else if (flashActive) {
+      if (nowMs - lastFlashMs >= FLASH_PERIOD_MS) {
+        lastFlashMs = nowMs;
+        flashOn = !flashOn;
+        if (flashOn) {
+          tft.fillScreen(TFT_BLUE);
+        } else {
+          redrawDash();
+          drawn = view;
+          latencyMark(LAT_DRAW, view);
+        }
+      }
+    } else if (wasFlashActive) {
+      // Schodzimy z odcinki – przywróć pełny UI
+      redrawDash();
+      drawn = view;
+      flashOn = false;
+    } else if (changed) {
+      // Tylko widżety, których wartość faktycznie się zmieniła
+      if (view.rpm != drawn.rpm) {
+        updateRpm(view.rpm);
+        latencyMark(LAT_DRAW, view);
+      }
+      if (view.speed != drawn.speed) updateSpeed(view.speed);
+      if (view.gear != drawn.gear || view.gearConfidence / 10 != drawn.gearConfidence / 10)
+        updateGear(view.gear, view.gearConfidence);
+      drawBottomPanel();
+      drawn = view;
+    }
+    changed = false;
+    wasFlashActive = flashActive;
+
+    renderStats.busyUs += micros() - startUs;
+  }
+}
+
+static void reportTask(TaskStats& st, uint32_t windowUs) {
+  uint32_t busy = st.busyUs;
+  uint32_t permille = (uint32_t)((uint64_t)(busy - st.lastBusyUs) * 1000 / windowUs);
+  st.lastBusyUs = busy;
+  Serial.printf(" %s load=%lu.%lu%% stack_free=%luB", st.name,
+                (unsigned long)(permille / 10), (unsigned long)(permille % 10),
+                (unsigned long)uxTaskGetStackHighWaterMark(st.handle));
 }
 
 void setup() {
@@ -353,190 +1149,140 @@ void setup() {
     }
   }
 
-  // Wejście RPM i biegi
-  pinMode(PIN_RPM, INPUT_PULLUP);
-  attachInterrupt(digitalPinToInterrupt(PIN_RPM), rpmIsr, FALLING);
-  pinMode(PIN_1_BIEG, INPUT_PULLUP);
-  pinMode(PIN_N_BIEG, INPUT_PULLUP);
-  pinMode(PIN_2_BIEG, INPUT_PULLUP);
+  // Biegi i LED (wejścia RPM/Halla podpina zadanie czujników na rdzeniu 0);
+  // piny wspólne z dotykiem (1, 2, N) ustawia arbiter
+  sharedPinHal.gearMode();
   pinMode(PIN_3_BIEG, INPUT_PULLUP);
   pinMode(PIN_4_BIEG, INPUT_PULLUP);
   pinMode(PIN_5_BIEG, INPUT_PULLUP);
-  pinMode(LED_B_PIN, OUTPUT); digitalWrite(LED_B_PIN, HIGH);
+  startShiftLight();
+#if GEAR_BENCH
+  benchGearRead();
+#endif
 
-  // Dotyk rezystancyjny – ustaw spoczynkowo wejścia
-  pinMode(RES_XP, INPUT);
-  pinMode(RES_XM, INPUT);
-  pinMode(RES_YP, INPUT);
-  pinMode(RES_YM, INPUT);
-  touchCalibrated = false;
-  touchCalibStartMs = millis();
+#if TOUCH_PANEL_CST820
+  // Dotyk pojemnościowy – gesty z układu, odczyt I2C tylko po przerwaniu TP_INT
+  touchInput.begin(millis());
+  if (!touchInput.ready()) Serial.println("[TOUCH] CST820 bez przerwania");
+#else
+  // Dotyk rezystancyjny – spoczynkowo piny należą do biegów (arbiter), pomiar przez ADC1 DMA;
+  // zapisana kalibracja działa od razu, bez czekania na ciszę na panelu
+  touchAdcInit();
+  bool calRestored = loadTouchCalibration(touchCalSaved);
+  touchCalStored.store(calRestored, std::memory_order_relaxed);
+  touchInput.begin(millis(), calRestored ? &touchCalSaved : nullptr);
+  if (calRestored) {
+    Serial.printf("[TOUCH] Calibration restored baseY=%d baseX=%d\n", touchCalSaved.baseY, touchCalSaved.baseX);
+  }
+#endif
 
-  drawStaticUi();
-  updateRpm(currentRpm);
-  updateSpeed(currentSpeed);
-  updateGear(currentGear);
+  redrawDash();
+
+  xTaskCreatePinnedToCore(sensorTask, "sensor", 4096, nullptr, 3, &sensorStats.handle, 0);
+  xTaskCreatePinnedToCore(renderTask, "render", 8192, nullptr, 1, &renderStats.handle, 1);
 }
 
 void loop() {
-  // Symulacja zmian (do testów UI). Podmień na realne odczyty z czujników.
-  static uint32_t last = 0;
-  if (millis() - last > 200) {
-    last = millis();
-
-    // Realne RPM z liczby impulsów: 4T -> RPM = impulsy * 120 (imp/s * 60 * 2)
-    static uint32_t lastRpmCalcMs = millis();
-    uint32_t nowMs = millis();
-    uint32_t dtMs = nowMs - lastRpmCalcMs;
-    if (dtMs >= 250) { // okno 0.25 s
-      noInterrupts();
-      uint32_t pulses = rpmPulseCount; rpmPulseCount = 0;
-      interrupts();
-      float pulsesPerSec = (dtMs > 0) ? (pulses * 1000.0f / dtMs) : 0.0f;
-      float rpmf = pulsesPerSec * 120.0f; // dla 4-suwa
-      if (rpmf < 0) rpmf = 0; if (rpmf > 20000) rpmf = 20000;
-      currentRpm = (uint16_t)rpmf;
-      lastRpmCalcMs = nowMs;
-    }
-
-    // Bieg – odczyt aktywnego GND na wejściach (N=0, 1..5)
-    int8_t gear = -1;
-    bool nLow = (digitalRead(PIN_N_BIEG) == LOW);
-    bool g1Low = (digitalRead(PIN_1_BIEG) == LOW);
-    bool g2Low = (digitalRead(PIN_2_BIEG) == LOW);
-    bool g3Low = (digitalRead(PIN_3_BIEG) == LOW);
-    bool g4Low = (digitalRead(PIN_4_BIEG) == LOW);
-    bool g5Low = (digitalRead(PIN_5_BIEG) == LOW);
-    if (nLow) gear = 0;
-    else if (g1Low) gear = 1;
-    else if (g2Low) gear = 2;
-    else if (g3Low) gear = 3;
-    else if (g4Low) gear = 4;
-    else if (g5Low) gear = 5;
-    static int8_t lastGearDebug = -9;
-    if (gear >= 0) {
-      currentGear = gear;
-      if (gear != lastGearDebug) {
-        Serial.printf("[GEAR] N=%d 1=%d 2=%d 3=%d 4=%d 5=%d -> gear=%d\n", nLow, g1Low, g2Low, g3Low, g4Low, g5Low, gear);
-        lastGearDebug = gear;
-      }
-    } else {
-      // brak aktywnego wejścia – log jednorazowy
-      if (lastGearDebug != -1) {
-        Serial.printf("[GEAR] brak aktywnego pinu N/1/2/3/4/5 (N=%d 1=%d 2=%d 3=%d 4=%d 5=%d)\n", nLow, g1Low, g2Low, g3Low, g4Low, g5Low);
-        lastGearDebug = -1;
-      }
-    }
-
-    // Na razie prędkość stała 0 (do czasu podłączenia Halla)
-    currentSpeed = 0;
-
-    // (opcjonalnie) sygnał zmiany biegu – na razie wyłączony
-
-    // Sygnał zmiany biegu przy 6000 RPM – miganie diodą LED (IO16, aktywnie LOW)
-    static bool shiftFlashOn = false;
-    static bool wasShiftActive = false;
-    const uint16_t SHIFT_RPM = 6000;
-    bool shiftActive = (currentRpm >= SHIFT_RPM && currentRpm < 10000);
-    if (shiftActive) {
-      shiftFlashOn = !shiftFlashOn;
-      ledBlue(shiftFlashOn);
-    } else if (wasShiftActive) {
-      ledBlue(false);
-      shiftFlashOn = false;
-    }
-    wasShiftActive = shiftActive;
-
-    // Miganie całego ekranu na czerwono przy wysokich RPM
-    static bool flashOn = false;         // stan klatki (czerwony/ekran UI)
-    static bool wasFlashActive = false;  // czy poprzednio był aktywny alert
-    const uint16_t THRESH = 10000;       // próg odcinki – dopasuj
-
-    bool flashActive = (currentRpm >= THRESH);
-    if (flashActive) {
-      flashOn = !flashOn;
-      if (flashOn) {
-        tft.fillScreen(TFT_BLUE);
-      } else {
-        drawStaticUi();
-        updateSpeed(currentSpeed);
-        updateGear(currentGear);
-        updateRpm(currentRpm);
-      }
-    } else if (wasFlashActive) {
-      // Schodzimy z odcinki – przywróć pełny UI
-      drawStaticUi();
-      updateSpeed(currentSpeed);
-      updateGear(currentGear);
-      updateRpm(currentRpm);
-      flashOn = false;
-    }
-    wasFlashActive = flashActive;
-
-    updateRpm(currentRpm);
-    updateSpeed(currentSpeed);
-    updateGear(currentGear);
-  }
-
-  // Detekcja pojedynczego tapnięcia – rezystancyjny
-  static uint32_t lastTouchPoll = 0;
-  if (millis() - lastTouchPoll > 25) {
-    lastTouchPoll = millis();
-    // Zasil X, czytaj Y+
-    pinMode(RES_XP, OUTPUT); digitalWrite(RES_XP, HIGH);
-    pinMode(RES_XM, OUTPUT); digitalWrite(RES_XM, LOW);
-    pinMode(RES_YP, INPUT);
-    int rawY = analogRead(RES_YP);
-    // Zasil Y, czytaj X+
-    pinMode(RES_YP, OUTPUT); digitalWrite(RES_YP, HIGH);
-    pinMode(RES_YM, OUTPUT); digitalWrite(RES_YM, LOW);
-    pinMode(RES_XP, INPUT);
-    int rawX = analogRead(RES_XP);
-
-    if (TOUCH_DEBUG && (millis() % 250 < 25)) {
-      Serial.printf("[TOUCH] rawY=%d rawX=%d\n", rawY, rawX);
+  // loop() służy już tylko do raportów diagnostycznych i zapisu kalibracji dotyku
+  static uint32_t lastReportUs = micros();
+  delay(TASK_REPORT_MS);
+  uint32_t nowUs = micros();
+  uint32_t windowUs = nowUs - lastReportUs;
+  lastReportUs = nowUs;
+  if (TASK_REPORT) {
+    Serial.print("[TASK]");
+    reportTask(sensorStats, windowUs);
+    reportTask(renderStats, windowUs);
+    Serial.printf(" gear_irq=%lu gear_block_max=%luus gear_deferred=%lu", (unsigned long)gearIrqCount,
+                  (unsigned long)pinArbiter.maxGearBlockUs(), (unsigned long)pinArbiter.gearDeferred());
+    // Koszt dotyku: średnie okno i udział w czasie raportu
+    static uint32_t lastTouchWindows = 0, lastTouchUs = 0;
+    uint32_t windows = pinArbiter.touchWindows(), touchUs = pinArbiter.touchUs();
+    uint32_t dWindows = windows - lastTouchWindows, dTouchUs = touchUs - lastTouchUs;
+    lastTouchWindows = windows;
+    lastTouchUs = touchUs;
+    if (dWindows) {
+      Serial.printf(" touch_win=%luus touch_load=%lu.%lu%%", (unsigned long)(dTouchUs / dWindows),
+                    (unsigned long)(dTouchUs * 100ULL / windowUs), (unsigned long)(dTouchUs * 1000ULL / windowUs % 10));
     }
+    Serial.println();
+  }
+  latencyReport();
+#if !TOUCH_PANEL_CST820
+  saveTouchCalibration();
+#endif
+}
 
-    touchEmaY = (int)(0.7f * touchEmaY + 0.3f * rawY);
-    touchEmaX = (int)(0.7f * touchEmaX + 0.3f * rawX);
+// Zdarzenia dotyku dla UI (zadanie czujników)
+static void pollTouch() {
+  uint32_t now = millis();
+  touchInput.poll(now, [](const TouchEvent& ev) {
+    if (!gestureQueue.push(ev)) Serial.println("[TOUCH] Gesture queue full");
+    else if (TOUCH_DEBUG) Serial.printf("[TOUCH] Gesture %u\n", ev.gesture);
+  });
 
-    if (!touchCalibrated && millis() - touchCalibStartMs >= TOUCH_CALIB_MS) {
-      baseY = touchEmaY; baseX = touchEmaX;
-      thrPressY = baseY + 250; thrReleaseY = baseY + 120;
-      touchCalibrated = true;
-      Serial.printf("[TOUCH] Calibrated baseY=%d baseX=%d thrP=%d thrR=%d\n", baseY, baseX, thrPressY, thrReleaseY);
+#if !TOUCH_PANEL_CST820
+  const TouchReading& r = touchInput.lastReading();
+  if (TOUCH_DEBUG && (now % 250 < 25)) {
+    Serial.printf("[TOUCH] rawY=%d rawX=%d z=%u used=%u short=%lu\n", r.y, r.x, r.z, r.used,
+                  (unsigned long)touchAdcShort);
+  }
+  static uint32_t calVersion = 0;
+  if (touchInput.calibrationVersion() != calVersion) {
+    const TouchCalibration& c = touchInput.calibration();
+    // Pierwsza kalibracja po starcie (bez zapisanej) – log; kroki dryfu tylko do loop()
+    if (calVersion == 0 && !touchCalStored.load(std::memory_order_relaxed)) {
+      Serial.printf("[TOUCH] Calibrated baseY=%d baseX=%d thrP=%d thrR=%d\n", c.baseY, c.baseX, c.thrPressY, c.thrReleaseY);
     }
-
-    bool active = (touchCalibrated && ((touchEmaY >= thrPressY) || (touchEmaX >= baseX + deltaMarginX)));
-    if (!isPressed && active) {
-      isPressed = true;
-      uint32_t now = millis();
-      if (now - lastSwitchMs > TOUCH_SWITCH_DEBOUNCE_MS) {
-        bottomMode = (BottomMode)(((int)bottomMode + 1) % 3);
-        drawBottomPanel();
-        Serial.println("[TOUCH] Single-tap -> switch panel");
-        lastSwitchMs = now;
-      }
-    } else if (isPressed && (touchEmaY <= thrReleaseY) && (touchEmaX <= baseX + (deltaMarginX/2))) {
-      isPressed = false;
+    // Zawieszony nacisk (np. nieaktualna zapisana kalibracja) – kalibracja od nowa
+    static uint32_t stuckReleases = 0;
+    if (touchInput.stuckReleases() != stuckReleases) {
+      stuckReleases = touchInput.stuckReleases();
+      Serial.printf("[TOUCH] Stuck press released, recalibrated baseY=%d baseX=%d\n", c.baseY, c.baseX);
     }
+    calVersion = touchInput.calibrationVersion();
+    touchCalShared.write(c);
+  }
+  static uint32_t tracedSamples = 0;
+  if (TOUCH_TRACE && touchInput.samples() != tracedSamples) {
+    tracedSamples = touchInput.samples();
+    Serial.printf("[TRACE] %lu %d %u %u\n", (unsigned long)now, touchInput.pressed() ? 1 : 0,
+                  touchInput.touchX(), touchInput.touchY());
   }
+#endif
 }
 
-static void drawBottomPanel() {
-  // Integrowanie dystansu i motogodzin
-  uint32_t now = millis();
-  if (lastIntegrateMs == 0) lastIntegrateMs = now;
-  uint32_t dt = now - lastIntegrateMs;
-  if (dt > 0) {
-    // dystans [km] = (km/h) * (dt[h])
-    float d_km = (float)currentSpeed * (dt / 3600000.0f);
-    odomKm += d_km;
-    tripKm += d_km;
-    // motogodziny: licz tylko gdy RPM > 0 (symulacja)
-    if (currentRpm > 0) motoHours += dt / 3600000.0f;
-    lastIntegrateMs = now;
+// Licznik w dziesiątych częściach jednostki jako "X.Y" – bez float
+static void formatTenths(char* buf, size_t len, const char* label, uint64_t tenths, const char* unit) {
+  snprintf(buf, len, "%s %lu.%lu %s", label, (unsigned long)(tenths / 10), (unsigned long)(tenths % 10), unit);
+}
+
+static void drawBottomPanel(bool force) {
+  char line[40];
+  switch (bottomMode) {
+    case MODE_ODOM:
+      formatTenths(line, sizeof(line), "ODO", view.odomMm / MM_PER_TENTH_KM, "km");
+      break;
+    case MODE_TRIP:
+      formatTenths(line, sizeof(line), "TRIP", view.tripMm / MM_PER_TENTH_KM, "km");
+      break;
+    case MODE_HOURS:
+      formatTenths(line, sizeof(line), "MOTO", view.motoMs / MS_PER_TENTH_H, "h");
+      break;
+    case MODE_DIAG:
+      // Narastające liczniki: zgubione iskry (misfire), zakłócenia z cewki, błędy czujników biegu
+      snprintf(line, sizeof(line), "MISS %lu NOISE %lu GEAR %lu",
+               (unsigned long)view.missedPulses, (unsigned long)view.noisePulses,
+               (unsigned long)view.gearFaults);
+      break;
+    default:
+      line[0] = 0;
+      break;
   }
+  // Ten sam tekst już jest na ekranie – nic do rysowania
+  static char lastLine[40] = "";
+  if (!force && strcmp(line, lastLine) == 0) return;
+  strcpy(lastLine, line);
 
   // Render dolnego paska
   tft.fillRect(AREA_LABEL.x, AREA_LABEL.y, AREA_LABEL.w, AREA_LABEL.h, TFT_BLACK);
@@ -550,19 +1296,76 @@ static void drawBottomPanel() {
     #endif
   }
 
-  char line[32];
-  switch (bottomMode) {
-    case MODE_ODOM:
-      snprintf(line, sizeof(line), "ODO %.1f km", odomKm);
-      break;
-    case MODE_TRIP:
-      snprintf(line, sizeof(line), "TRIP %.1f km", tripKm);
-      break;
-    case MODE_HOURS:
-      snprintf(line, sizeof(line), "MOTO %.1f h", motoHours);
-      break;
-  }
   tft.drawString(line, AREA_LABEL.x + AREA_LABEL.w / 2, AREA_LABEL.y + AREA_LABEL.h / 2);
 
   if (smoothFontsReady) tft.unloadFont();
-}
\ No newline at end of file
+}
+
+// Ekran pomiaru przyspieszenia: stan, bieżący przebieg i historia ostatnich wyników
+static void formatLaunchTime(char* buf, size_t len, uint32_t us) {
+  if (us == 0) snprintf(buf, len, "--.---");
+  else snprintf(buf, len, "%lu.%03lu", (unsigned long)(us / 1000000), (unsigned long)(us / 1000 % 1000));
+}
+
+static void drawLaunchScreen(bool full) {
+  static LaunchTimer::State lastState = LaunchTimer::IDLE;
+  static uint32_t lastRuns = 0xFFFFFFFF;
+  const LaunchTimer& launch = view.launch;
+  LaunchTimer::State st = launch.state();
+  // Przerysuj tylko przy zmianie stanu/wyniku albo w trakcie przebiegu (licznik czasu)
+  if (!full && st == lastState && launch.runs() == lastRuns && st != LaunchTimer::RUNNING) return;
+  lastState = st;
+  lastRuns = launch.runs();
+
+  if (full) tft.fillScreen(TFT_BLACK);
+  tft.fillRect(0, 0, tft.width(), 96, TFT_BLACK);
+  tft.setTextDatum(MC_DATUM);
+  if (smoothFontsReady) {
+    tft.loadFont(FONT_LABEL_VLW);
+  } else {
+    #if HAS_FSB12
+      tft.setFreeFont(&FreeSansBold12pt7b);
+    #endif
+  }
+
+  const char* title = "LAUNCH";
+  uint16_t col = TFT_DARKGREY;
+  switch (st) {
+    case LaunchTimer::IDLE:    title = "ZATRZYMAJ SIE"; col = TFT_DARKGREY; break;
+    case LaunchTimer::ARMED:   title = "GOTOWY";        col = TFT_GREEN;    break;
+    case LaunchTimer::RUNNING: title = "POMIAR";        col = TFT_YELLOW;   break;
+    case LaunchTimer::DONE:    title = "WYNIK";         col = TFT_CYAN;     break;
+  }
+  tft.setTextColor(col, TFT_BLACK);
+  tft.drawString(title, tft.width() / 2, 20);
+
+  char a[12], b[12], c[12], line[48];
+  const LaunchTimer::Result& cur = (st == LaunchTimer::DONE && launch.historyCount() > 0)
+                                     ? launch.history(0) : launch.current();
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  if (st == LaunchTimer::RUNNING) {
+    formatLaunchTime(a, sizeof(a), launch.elapsedUs(micros()));
+    snprintf(line, sizeof(line), "%s s", a);
+    tft.drawString(line, tft.width() / 2, 52);
+  }
+  formatLaunchTime(a, sizeof(a), cur.t50Us);
+  formatLaunchTime(b, sizeof(b), cur.t100Us);
+  formatLaunchTime(c, sizeof(c), cur.t60mUs);
+  snprintf(line, sizeof(line), "50:%s 100:%s 60m:%s", a, b, c);
+  tft.drawString(line, tft.width() / 2, 80);
+
+  if (full || st == LaunchTimer::DONE) {
+    tft.fillRect(0, 100, tft.width(), tft.height() - 100, TFT_BLACK);
+    tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
+    for (uint8_t i = 0; i < launch.historyCount(); i++) {
+      const LaunchTimer::Result& r = launch.history(i);
+      formatLaunchTime(a, sizeof(a), r.t50Us);
+      formatLaunchTime(b, sizeof(b), r.t100Us);
+      formatLaunchTime(c, sizeof(c), r.t60mUs);
+      snprintf(line, sizeof(line), "%u) %s  %s  %s", (unsigned)(i + 1), a, b, c);
+      tft.drawString(line, tft.width() / 2, 116 + i * 24);
+    }
+  }
+
+  if (smoothFontsReady) tft.unloadFont();
+}
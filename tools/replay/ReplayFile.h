@@ -0,0 +1,59 @@
+#ifndef _REPLAY_FILE_H
+#define _REPLAY_FILE_H
+
+// Wspólny odczyt plików tekstowych narzędzi replay (pulse_replay, led_bar_sim, gesture_replay).
+// Linia na rekord, wiodące odstępy pomijane, puste linie i '#' to komentarz.
+// Linia dłuższa niż bufor jest ucinana, a jej reszta pomijana – inaczej ogon długiego
+// nagłówka (np. polecenie sprawdzenia z progami) wróciłby jako osobny rekord.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+class LineReader {
+public:
+  explicit LineReader(FILE* f) : _f(f) {}
+
+  // Następna linia z danymi (od pierwszego znaku, z '\n') albo nullptr na końcu pliku
+  char* next() {
+    while (fgets(_line, sizeof(_line), _f)) {
+      bool tail = _continuation;
+      _continuation = !strchr(_line, '\n');
+      if (tail) continue;
+      char* p = _line;
+      while (*p == ' ' || *p == '\t') p++;
+      if (*p == '#' || *p == '\n' || *p == '\r' || *p == 0) continue;
+      return p;
+    }
+    return nullptr;
+  }
+
+private:
+  FILE* _f;
+  char _line[256];
+  bool _continuation = false;
+};
+
+// Plik impulsów: "t_us [rpm_ref]" na zbocze
+struct Edge { uint64_t tUs; double refRpm; };
+
+// hasRef = każde zbocze ma kolumnę rpm_ref; tag prefiksuje komunikat błędu ("[REPLAY]", "[LED]")
+static inline bool loadEdges(const char* path, std::vector<Edge>& edges, bool& hasRef, const char* tag) {
+  FILE* f = fopen(path, "r");
+  if (!f) { fprintf(stderr, "%s nie mogę otworzyć %s\n", tag, path); return false; }
+  LineReader in(f);
+  hasRef = true;
+  while (char* p = in.next()) {
+    double t = 0, ref = 0;
+    int n = sscanf(p, "%lf %lf", &t, &ref);
+    if (n < 1) continue;
+    if (n < 2) hasRef = false;
+    edges.push_back({ (uint64_t)t, ref });
+  }
+  fclose(f);
+  if (edges.empty()) hasRef = false;
+  return true;
+}
+
+#endif
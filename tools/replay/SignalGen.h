@@ -0,0 +1,106 @@
+#ifndef _SIGNAL_GEN_H
+#define _SIGNAL_GEN_H
+
+// Syntetyczny sygnał z cewki zapłonowej dla pulse_replay i rpm_fuzz.
+// Generuje znaczniki czasu zboczy [us] razem z prawdziwym RPM (kolumna referencyjna),
+// opcjonalnie z zakłóceniami: zgubione iskry, podwójne wyzwolenia (dzwonienie) i serie EMI.
+// Deterministyczny – ten sam seed daje ten sam strumień.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+namespace signalgen {
+
+struct Edge { uint64_t tUs; double refRpm; bool noise; };
+
+// xorshift32 – przenośny, bez zależności od implementacji rand()
+struct Rng {
+  uint32_t s;
+  explicit Rng(uint32_t seed) : s(seed ? seed : 0x9E3779B9u) {}
+  uint32_t next() { s ^= s << 13; s ^= s >> 17; s ^= s << 5; return s; }
+  double unit() { return (next() >> 8) * (1.0 / 16777216.0); }          // [0, 1)
+  double range(double lo, double hi) { return lo + (hi - lo) * unit(); }
+  bool chance(double p) { return unit() < p; }
+};
+
+// Profil RPM w czasie
+enum Shape { SHAPE_IDLE, SHAPE_SWEEP };
+
+struct Noise {
+  double missProb = 0.0;        // prawdopodobieństwo zgubienia iskry
+  double doubleProb = 0.0;      // prawdopodobieństwo dodatkowego zbocza od dzwonienia
+  uint32_t ringMinUs = 50;      // opóźnienie zbocza od dzwonienia
+  uint32_t ringMaxUs = 1500;
+  double burstPerSec = 0.0;     // średnia liczba serii EMI na sekundę
+  uint32_t burstEdges = 20;     // zbocza w serii
+  uint32_t burstSpanUs = 5000;  // czas trwania serii
+  double jitter = 0.0;          // względny jitter okresu (np. 0.01 = 1%)
+};
+
+struct Scenario {
+  Shape shape = SHAPE_IDLE;
+  double idleRpm = 1500;
+  double sweepFromRpm = 1500;
+  double sweepToRpm = 12000;
+  double sweepSeconds = 3.0;    // jeden kierunek; przebieg w górę i w dół
+  double seconds = 5.0;
+  Noise noise;
+};
+
+// RPM "prawdziwe" w chwili t [s]
+inline double rpmAt(const Scenario& sc, double t) {
+  if (sc.shape == SHAPE_IDLE) return sc.idleRpm;
+  double phase = fmod(t, 2.0 * sc.sweepSeconds) / sc.sweepSeconds; // 0..2
+  double k = phase <= 1.0 ? phase : 2.0 - phase;
+  return sc.sweepFromRpm + (sc.sweepToRpm - sc.sweepFromRpm) * k;
+}
+
+// revsPerPulse = REVS_PER_CYCLE / PULSES_PER_CYCLE profilu (4T: 2, 2T: 1)
+inline std::vector<Edge> generate(const Scenario& sc, double revsPerPulse, uint32_t seed, uint64_t startUs = 1000000) {
+  Rng rng(seed);
+  std::vector<Edge> out;
+  double t = 0;
+  double nextBurst = sc.noise.burstPerSec > 0 ? -log(1.0 - rng.unit()) / sc.noise.burstPerSec : 1e30;
+  while (t < sc.seconds) {
+    double rpm = rpmAt(sc, t);
+    double period = revsPerPulse * 60.0 / rpm;
+    if (sc.noise.jitter > 0) period *= 1.0 + rng.range(-sc.noise.jitter, sc.noise.jitter);
+    t += period;
+    uint64_t tUs = startUs + (uint64_t)(t * 1e6);
+
+    // Seria EMI – losowe zbocza upchnięte w krótkim oknie
+    while (nextBurst < t) {
+      uint64_t b0 = startUs + (uint64_t)(nextBurst * 1e6);
+      for (uint32_t i = 0; i < sc.noise.burstEdges; i++) {
+        uint64_t bt = b0 + (uint64_t)rng.range(0, sc.noise.burstSpanUs);
+        out.push_back({bt, rpmAt(sc, nextBurst), true});
+      }
+      nextBurst += -log(1.0 - rng.unit()) / sc.noise.burstPerSec;
+    }
+
+    if (rng.chance(sc.noise.missProb)) continue; // zgubiona iskra
+    out.push_back({tUs, rpm, false});
+    if (rng.chance(sc.noise.doubleProb)) {
+      out.push_back({tUs + (uint64_t)rng.range(sc.noise.ringMinUs, sc.noise.ringMaxUs), rpm, true});
+    }
+  }
+  // Zbocza z serii EMI mogą wypaść przed wcześniejszymi – ISR widzi je w kolejności czasu
+  for (size_t i = 1; i < out.size(); i++) {
+    Edge e = out[i];
+    size_t j = i;
+    while (j > 0 && out[j - 1].tUs > e.tUs) { out[j] = out[j - 1]; j--; }
+    out[j] = e;
+  }
+  return out;
+}
+
+// Zapis w formacie wejściowym pulse_replay: "t_us rpm_ref"
+inline void write(FILE* f, const std::vector<Edge>& edges) {
+  for (const Edge& e : edges) fprintf(f, "%llu %.0f\n", (unsigned long long)e.tUs, e.refRpm);
+}
+
+} // namespace signalgen
+
+#endif
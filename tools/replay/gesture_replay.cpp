@@ -0,0 +1,86 @@
+// Host-owe odtwarzanie rozpoznawania gestów (src/GestureRecognizer.h) z nagranego śladu dotyku.
+// Ślad to log z TOUCH_TRACE = true w src/main.cpp: "[TRACE] t_ms pressed x y" na linię
+// (prefiks "[TRACE]" opcjonalny, inne linie logu są pomijane, '#' zaczyna komentarz).
+// Wypisuje "t_ms GEST" dla każdego gestu; z --expect porównuje listę gestów ze wzorcem
+// (nazwy rozdzielone przecinkami) i zwraca 1 przy różnicy – uruchamiane przez run_checks.sh.
+// Stałe ślady z oczekiwanymi gestami w nagłówkach: tools/replay/data/gesture_*.txt.
+//
+// Kompilacja (z katalogu repo):
+//   g++ -std=gnu++17 -O2 -Isrc -Itools/replay tools/replay/gesture_replay.cpp -o gesture_replay
+//
+// Użycie:
+//   gesture_replay <plik_sladu> [--tap-ms N] [--double-ms N] [--long-ms N] [--swipe-dist N] [--swipe-ms N]
+//                  [--expect TAP,SWIPE_LEFT,...]
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "GestureRecognizer.h"
+#include "ReplayFile.h"
+
+static const char* const NAMES[] = { "NONE", "TAP", "DOUBLE_TAP", "LONG_PRESS",
+                                     "SWIPE_LEFT", "SWIPE_RIGHT", "SWIPE_UP", "SWIPE_DOWN" };
+
+int main(int argc, char** argv) {
+  const char* inPath = nullptr;
+  const char* expect = nullptr;
+  GestureConfig cfg;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    bool hasVal = i + 1 < argc;
+    if (!strcmp(a, "--tap-ms") && hasVal) cfg.tapMaxMs = (uint16_t)atoi(argv[++i]);
+    else if (!strcmp(a, "--double-ms") && hasVal) cfg.doubleTapGapMs = (uint16_t)atoi(argv[++i]);
+    else if (!strcmp(a, "--long-ms") && hasVal) cfg.longPressMs = (uint16_t)atoi(argv[++i]);
+    else if (!strcmp(a, "--swipe-dist") && hasVal) cfg.swipeMinDist = (uint16_t)atoi(argv[++i]);
+    else if (!strcmp(a, "--swipe-ms") && hasVal) cfg.swipeMaxMs = (uint16_t)atoi(argv[++i]);
+    else if (!strcmp(a, "--expect") && hasVal) expect = argv[++i];
+    else if (a[0] != '-') inPath = a;
+    else { fprintf(stderr, "[GEST] nieznana opcja %s\n", a); return 2; }
+  }
+  if (!inPath) {
+    fprintf(stderr, "użycie: %s <plik_sladu> [--tap-ms N] [--double-ms N] [--long-ms N] [--swipe-dist N] [--swipe-ms N] [--expect LISTA]\n", argv[0]);
+    return 2;
+  }
+
+  FILE* f = fopen(inPath, "r");
+  if (!f) { fprintf(stderr, "[GEST] nie mogę otworzyć %s\n", inPath); return 1; }
+
+  GestureRecognizer rec(cfg);
+  std::string got;
+  uint32_t samples = 0, gestures = 0, lastMs = 0;
+  LineReader in(f);
+  while (char* p = in.next()) {
+    if (!strncmp(p, "[TRACE]", 7)) p += 7;
+    else if (*p == '[') continue;  // inne linie logu firmware
+    unsigned long t = 0;
+    int pressed = 0, x = 0, y = 0;
+    if (sscanf(p, "%lu %d %d %d", &t, &pressed, &x, &y) != 4) continue;
+    samples++;
+    lastMs = (uint32_t)t;
+    Gesture g = rec.update(lastMs, pressed != 0, (uint16_t)x, (uint16_t)y);
+    if (g == GESTURE_NONE) continue;
+    printf("%lu %s\n", t, NAMES[g]);
+    if (gestures++) got += ',';
+    got += NAMES[g];
+  }
+  fclose(f);
+
+  // Koniec śladu: pojedynczy tap czekający na drugi zostaje rozstrzygnięty
+  Gesture g = rec.update(lastMs + cfg.doubleTapGapMs + 1, false, 0, 0);
+  if (g != GESTURE_NONE) {
+    printf("%lu %s\n", (unsigned long)(lastMs + cfg.doubleTapGapMs + 1), NAMES[g]);
+    if (gestures++) got += ',';
+    got += NAMES[g];
+  }
+
+  fprintf(stderr, "[GEST] samples=%u gestures=%u\n", (unsigned)samples, (unsigned)gestures);
+  if (expect && got != expect) {
+    fprintf(stderr, "[GEST] oczekiwano %s, jest %s\n", expect, got.c_str());
+    return 1;
+  }
+  return 0;
+}
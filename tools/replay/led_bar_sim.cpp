@@ -0,0 +1,148 @@
+// Host-owa emulacja listwy LED zmiany biegu (src/LedBar.h).
+// Plik impulsów przechodzi przez ten sam RpmAcquisition co w firmware, a każda klatka
+// listwy (100 Hz, jak takt RMT w firmware) staje się jednym wierszem framebuffera:
+// szerokość = liczba diod, wysokość = liczba klatek. Obraz PPM da się porównać
+// z wzorcem albo obejrzeć – czas płynie z góry na dół.
+//
+// Kompilacja (z katalogu repo, profil jak w platformio.ini, np. -DENGINE_PROFILE_2T=1):
+//   g++ -std=gnu++17 -O2 -Isrc -Itools/replay tools/replay/led_bar_sim.cpp -o led_bar_sim
+//
+// Użycie:
+//   led_bar_sim <plik_impulsow> [--gear N] [--frame-ms N] [--brightness N] [--scale N] [-o listwa.ppm]
+//   led_bar_sim <plik_impulsow> --ascii       (wiersz tekstu na klatkę: "t_us . G Y R B")
+//   led_bar_sim <plik_impulsow> --expect wzorzec.txt
+//
+// Plik impulsów: jak dla pulse_replay ("t_us [rpm_ref]", '#' zaczyna komentarz).
+// --expect porównuje wiersze --ascii z zapisanym wzorcem ('#' to komentarz) i zwraca 1
+// przy pierwszej różnicy. Wzorzec: tools/replay/data/synthetic_sweep_4t.bar.txt
+// (odświeżenie po świadomej zmianie LedBar.h: --ascii > wzorzec, plus nagłówek).
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "RpmAcquisition.h"
+#include "LedBar.h"
+#include "ReplayFile.h"
+
+static const uint32_t RPM_IRQ_DEBOUNCE_US = 2000; // jak w src/main.cpp
+static const uint8_t LEDS = 8;                    // LED_BAR_LEDS w src/main.cpp
+typedef LedBar<ActiveEngine, LEDS> SimLedBar;
+
+// Wiersze wzorca bez komentarzy i końców linii
+static bool loadExpected(const char* path, std::vector<std::string>& rows) {
+  FILE* f = fopen(path, "r");
+  if (!f) { fprintf(stderr, "[LED] nie mogę otworzyć %s\n", path); return false; }
+  LineReader in(f);
+  while (char* p = in.next()) {
+    p[strcspn(p, "\r\n")] = 0;
+    rows.push_back(p);
+  }
+  fclose(f);
+  return true;
+}
+
+// Dominująca barwa diody jako znak (do szybkiego diffu ze wzorcem)
+static char ledChar(const uint8_t* grb) {
+  uint8_t g = grb[0], r = grb[1], b = grb[2];
+  if (!g && !r && !b) return '.';
+  if (b > r && b > g) return 'B';
+  if (r && g) return 'Y';
+  return r ? 'R' : 'G';
+}
+
+int main(int argc, char** argv) {
+  const char* inPath = nullptr;
+  const char* outPath = nullptr;
+  const char* expectPath = nullptr;
+  int gear = 3;
+  uint32_t frameMs = 10, scale = 8;
+  uint8_t brightness = 255;
+  bool ascii = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    bool hasVal = i + 1 < argc;
+    if (!strcmp(a, "--ascii")) ascii = true;
+    else if (!strcmp(a, "--gear") && hasVal) gear = atoi(argv[++i]);
+    else if (!strcmp(a, "--frame-ms") && hasVal) frameMs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--brightness") && hasVal) brightness = (uint8_t)atoi(argv[++i]);
+    else if (!strcmp(a, "--scale") && hasVal) scale = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "-o") && hasVal) outPath = argv[++i];
+    else if (!strcmp(a, "--expect") && hasVal) expectPath = argv[++i];
+    else if (a[0] != '-') inPath = a;
+    else { fprintf(stderr, "[LED] nieznana opcja %s\n", a); return 2; }
+  }
+  if (!inPath) {
+    fprintf(stderr, "użycie: %s <plik_impulsow> [--gear N] [--frame-ms N] [--brightness N] [--scale N] [--ascii] [--expect wzorzec.txt] [-o listwa.ppm]\n", argv[0]);
+    return 2;
+  }
+  if (frameMs == 0) frameMs = 1;
+  if (scale == 0) scale = 1;
+
+  std::vector<Edge> edges;
+  bool hasRef = false;
+  if (!loadEdges(inPath, edges, hasRef, "[LED]")) return 1;
+  if (edges.empty()) { fprintf(stderr, "[LED] brak zboczy\n"); return 1; }
+  std::vector<std::string> expected, rows;
+  if (expectPath && !loadExpected(expectPath, expected)) return 1;
+
+  // Wirtualny zegar 1 ms jak pętla czujników; klatka co frameMs
+  RpmAcquisition<ActiveEngine> acq(RPM_IRQ_DEBOUNCE_US);
+  SimLedBar bar(brightness);
+  std::vector<uint8_t> fb;  // framebuffer: wiersz = klatka, GRB jak na kablu
+  uint8_t frame[SimLedBar::FRAME_BYTES];
+  size_t next = 0;
+  uint64_t startUs = edges.front().tUs, endUs = edges.back().tUs + 500000, nextFrameUs = startUs;
+  uint32_t frames = 0, litFrames = 0;
+  for (uint64_t now = startUs; now <= endUs; now += 1000) {
+    while (next < edges.size() && edges[next].tUs <= now) acq.onEdge((uint32_t)edges[next++].tUs);
+    acq.poll();
+    if (now < nextFrameUs) continue;
+    nextFrameUs += (uint64_t)frameMs * 1000;
+    uint8_t lit = bar.render(acq.rpmAt((uint32_t)now, 0), (int8_t)gear, (uint32_t)now, frame);
+    fb.insert(fb.end(), frame, frame + sizeof(frame));
+    frames++;
+    if (lit) litFrames++;
+    if (ascii || expectPath) {
+      char leds[LEDS + 1], row[48];
+      for (uint8_t i = 0; i < LEDS; i++) leds[i] = ledChar(&frame[i * 3]);
+      leds[LEDS] = 0;
+      snprintf(row, sizeof(row), "%llu %s", (unsigned long long)now, leds);
+      if (ascii) printf("%s\n", row);
+      if (expectPath) rows.push_back(row);
+    }
+  }
+
+  if (!ascii && !expectPath) {
+    FILE* out = outPath ? fopen(outPath, "wb") : stdout;
+    if (!out) { fprintf(stderr, "[LED] nie mogę zapisać %s\n", outPath); return 1; }
+    // PPM (RGB): każda dioda scale x 1 pikseli, jeden wiersz na klatkę
+    fprintf(out, "P6\n%u %u\n255\n", (unsigned)(LEDS * scale), (unsigned)frames);
+    for (uint32_t f = 0; f < frames; f++) {
+      for (uint8_t i = 0; i < LEDS; i++) {
+        const uint8_t* grb = &fb[(f * LEDS + i) * 3];
+        uint8_t rgb[3] = { grb[1], grb[0], grb[2] };
+        for (uint32_t s = 0; s < scale; s++) fwrite(rgb, 1, 3, out);
+      }
+    }
+    if (out != stdout) fclose(out);
+  }
+  fprintf(stderr, "[LED] frames=%u lit=%u gear=%d shift=%u flash=%u\n", (unsigned)frames, (unsigned)litFrames,
+          gear, (unsigned)ActiveEngine::shiftRpm((int8_t)gear), (unsigned)ActiveEngine::FLASH_RPM);
+  if (expectPath) {
+    for (size_t i = 0; i < rows.size() || i < expected.size(); i++) {
+      const char* got = i < rows.size() ? rows[i].c_str() : "(koniec)";
+      const char* want = i < expected.size() ? expected[i].c_str() : "(koniec)";
+      if (strcmp(got, want)) {
+        fprintf(stderr, "[LED] FAIL klatka %u: oczekiwano \"%s\", jest \"%s\"\n", (unsigned)i, want, got);
+        return 1;
+      }
+    }
+    fprintf(stderr, "[LED] zgodne z wzorcem: %u klatek\n", (unsigned)rows.size());
+  }
+  return 0;
+}
@@ -0,0 +1,202 @@
+// Host-owe sprawdzenie arbitra pinów wspólnych dotyk/biegi (src/PinArbiter.h).
+// Sztuczny Hal śledzi tryb każdego pinu i wirtualny czas; losowy harmonogram
+// (zbocza biegów, okna dotyku, kilka prób w jednym takcie) sprawdza, że:
+//   - próbka biegu nigdy nie trafia na piny w trybie dotyku ani przed czasem ustalenia,
+//   - pomiar dotyku nigdy nie dzieje się poza oknem dotyku,
+//   - próbka biegu czeka najwyżej maxGearBlockUs() + jeden takt pętli,
+//   - sam dotyk (bez zboczy biegów) nie podtrzymuje próbkowania po zboczu: reguła
+//     GearSchedule z zadania czujników daje tylko jednorazową próbkę po każdym oknie.
+// Kod wyjścia 1 przy pierwszym naruszeniu – uruchamiane przez run_checks.sh.
+//
+// Kompilacja (z katalogu repo):
+//   g++ -std=gnu++17 -O2 -Isrc tools/replay/pin_arbiter_check.cpp -o pin_arbiter_check
+//
+// Użycie:
+//   pin_arbiter_check [--seconds N] [--seed N]
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <initializer_list>
+
+#include "GearFilter.h"
+#include "GearSchedule.h"
+#include "PinArbiter.h"
+#include "TouchFrontEnd.h"
+
+static const uint8_t PIN_YP = 32, PIN_XP = 33, PIN_XM = 25, PIN_YM = 26; // jak RES_* w src/main.cpp
+static const uint32_t SETTLE_US = 200;                                   // SHARED_PIN_SETTLE_US
+static const uint32_t TICK_US = 1000;                                    // SENSOR_PERIOD_MS
+static const uint32_t GEAR_SAMPLE_MS = 5, GEAR_WINDOW_MS = 100;          // jak w src/main.cpp
+static const uint32_t GEAR_FALLBACK_MS = 500, TOUCH_PERIOD_MS = 25;
+static const uint8_t GEAR_N_CODE = 1;                                     // kod pinów: tylko luz
+
+enum Mode : uint8_t { M_PULLUP, M_INPUT, M_OUT_HIGH, M_OUT_LOW };
+
+struct FakeHal {
+  uint32_t nowUs = 0;
+  Mode mode[40] = {};
+  bool muted = false;
+  bool inWindow = false;     // ustawiane przez test wokół measure()
+  uint32_t gearModeUs = 0;   // ostatnie przywrócenie trybu biegu
+  uint32_t violations = 0;
+
+  uint32_t micros() const { return nowUs; }
+  void muteGear(bool m) { muted = m; nowUs += 1; }
+  void gearMode() {
+    mode[PIN_YP] = mode[PIN_XM] = mode[PIN_YM] = M_PULLUP;
+    mode[PIN_XP] = M_INPUT;
+    gearModeUs = nowUs;
+    nowUs += 8;
+  }
+  void drive(uint8_t pin, bool high) { check("drive"); mode[pin] = high ? M_OUT_HIGH : M_OUT_LOW; nowUs += 4; }
+  void release(uint8_t pin) { check("release"); mode[pin] = M_INPUT; nowUs += 4; }
+  void delayUs(uint32_t us) { check("settle"); nowUs += us; }
+  uint8_t burst(uint8_t pin, uint16_t* out, uint8_t n) {
+    check("burst");
+    if (mode[pin] != M_INPUT) fail("burst", "z pinu, ktory nie jest wejsciem");
+    for (uint8_t i = 0; i < n; i++) out[i] = (uint16_t)(2000 + pin + i % 5);
+    nowUs += 25u * n;  // 40 kHz jak TOUCH_ADC_HZ
+    return n;
+  }
+
+  void check(const char* what) {
+    if (!inWindow) fail(what, "poza oknem dotyku");
+  }
+  void fail(const char* what, const char* why) {
+    if (violations++ < 10) fprintf(stderr, "[ARB] t=%u us: %s %s\n", (unsigned)nowUs, what, why);
+  }
+};
+
+static uint32_t rng = 2463534242u;
+static uint32_t next() { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; }
+
+// Bezczynny dotyk: okno co TOUCH_PERIOD_MS, żadnych zboczy biegów, filtr spokojny.
+// Reguła próbkowania ta sama co w sensorTask (GearSchedule) – po oknie ma być dokładnie jedna próbka,
+// a okno GEAR_WINDOW_MS nie może się odnawiać (inaczej biegi co 5 ms bez końca).
+static void idleTouchCheck(FakeHal& hal, uint32_t seconds) {
+  hal.nowUs = 0;
+  hal.gearMode();
+  PinArbiter<FakeHal> arb(hal, SETTLE_US);
+  TouchFrontEnd<PIN_YP, PIN_XP, PIN_XM, PIN_YM> touchFrontEnd;
+  GearSchedule schedule(GEAR_SAMPLE_MS, GEAR_WINDOW_MS, GEAR_FALLBACK_MS);
+  // Filtr jak w src/main.cpp, ustalony na luzie – piny się nie zmieniają, busy() musi zgasnąć
+  GearFilter filter(4, 60000, 500000);
+  for (uint32_t t = 0; filter.busy() || filter.gear() < 0; t += GEAR_SAMPLE_MS) filter.update(GEAR_N_CODE, t * 1000);
+  uint32_t lastTouchPoll = 0;
+  uint32_t gearSamples = 0, activeTicks = 0;
+  for (uint32_t nowMs = 1; nowMs <= seconds * 1000; nowMs++) {
+    hal.nowUs = nowMs * 1000;
+    arb.service();
+    bool gearDue = schedule.due(nowMs, arb.gearRequested(), arb.gearEdgeRequested(), filter.busy());
+    if (schedule.active()) activeTicks++;
+    if (gearDue && arb.gear([&] { filter.update(GEAR_N_CODE, hal.nowUs); })) {
+      schedule.sampled(nowMs);
+      gearSamples++;
+    }
+    if (nowMs - lastTouchPoll > TOUCH_PERIOD_MS && !arb.gearRequested()) {
+      lastTouchPoll = nowMs;
+      arb.touch([&](FakeHal& h) {
+        h.inWindow = true;
+        touchFrontEnd.measure(h);
+        h.inWindow = false;
+      });
+    }
+  }
+  uint32_t windows = arb.touchWindows();
+  // Jedna próbka po każdym oknie plus ewentualne kontrolne
+  uint32_t maxSamples = windows + seconds * 1000 / GEAR_FALLBACK_MS + 1;
+  if (activeTicks) hal.fail("idle", "okno probkowania po zboczu odnawiane przez sam dotyk");
+  if (gearSamples < windows || gearSamples > maxSamples) hal.fail("idle", "liczba probek biegu nie odpowiada oknom dotyku");
+  fprintf(stderr, "[ARB] idle touch: windows=%u gear=%u active_ticks=%u\n", (unsigned)windows,
+          (unsigned)gearSamples, (unsigned)activeTicks);
+}
+
+int main(int argc, char** argv) {
+  uint32_t seconds = 60;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc) rng = (uint32_t)atol(argv[++i]) | 1;
+    else { fprintf(stderr, "użycie: %s [--seconds N] [--seed N]\n", argv[0]); return 2; }
+  }
+
+  FakeHal hal;
+  hal.gearMode();
+  PinArbiter<FakeHal> arb(hal, SETTLE_US);
+  TouchFrontEnd<PIN_YP, PIN_XP, PIN_XM, PIN_YM> touchFrontEnd;  // ten sam pomiar co firmware
+
+  uint32_t gearSamples = 0, touchWindows = 0, maxWaitUs = 0;
+  bool waiting = false;
+  uint32_t wantedSinceUs = 0;
+  uint32_t lastTouchUs = 0;
+  uint64_t ticks = (uint64_t)seconds * 1000000 / TICK_US;
+
+  for (uint64_t k = 0; k < ticks; k++) {
+    hal.nowUs = (uint32_t)((k + 1) * TICK_US);
+    arb.service();
+    if (next() % 50 == 0) arb.requestGear();  // "zbocze" biegu
+    if (arb.gearRequested() && !waiting) {
+      waiting = true;
+      wantedSinceUs = hal.nowUs;
+    }
+
+    auto tryGear = [&] {
+      bool ok = arb.gear([&] {
+        for (uint8_t p : { PIN_YP, PIN_XM, PIN_YM })
+          if (hal.mode[p] != M_PULLUP) hal.fail("gear", "na pinie poza INPUT_PULLUP");
+        if (hal.muted) hal.fail("gear", "przy wyciszonych przerwaniach biegu");
+        if (hal.nowUs - hal.gearModeUs < SETTLE_US) hal.fail("gear", "przed czasem ustalenia");
+        gearSamples++;
+      });
+      if (ok && waiting) {
+        uint32_t waitUs = hal.nowUs - wantedSinceUs;
+        if (waitUs > maxWaitUs) maxWaitUs = waitUs;
+        waiting = false;
+      }
+    };
+    auto tryTouch = [&] {
+      bool ok = arb.touch([&](FakeHal& h) {
+        h.inWindow = true;
+        if (!h.muted) h.fail("touch", "bez wyciszenia przerwan biegu");
+        touchFrontEnd.measure(h);
+        h.nowUs += next() % 300;  // zmienny czas pomiaru
+        h.inWindow = false;
+      });
+      if (ok) {
+        lastTouchUs = hal.nowUs;
+        touchWindows++;
+      }
+    };
+
+    // Jak zadanie czujników: żądana próbka biegu raz na takt, potem dotyk w swoim takcie
+    if (waiting) tryGear();
+    if (hal.nowUs - lastTouchUs >= 25000) tryTouch();
+    // Dodatkowe próby w losowej kolejności – arbiter ma odrzucić każdy przeplot
+    for (uint8_t n = (uint8_t)(next() % 4); n--;) {
+      uint32_t r = next() % 5;
+      if (r == 0) {
+        // Zbocze w środku taktu, np. tuż po oknie dotyku – obsłużone w kolejnym takcie
+        arb.requestGear();
+        if (!waiting) {
+          waiting = true;
+          wantedSinceUs = hal.nowUs;
+        }
+      } else if (r & 1) {
+        tryGear();
+      } else {
+        tryTouch();
+      }
+    }
+  }
+
+  uint32_t boundUs = arb.maxGearBlockUs() + TICK_US;
+  if (maxWaitUs > boundUs) hal.fail("gear", "czekal dluzej niz okno dotyku + ustalanie + takt");
+  fprintf(stderr, "[ARB] gear=%u touch=%u deferred=%u max_wait=%uus bound=%uus\n",
+          (unsigned)gearSamples, (unsigned)touchWindows, (unsigned)arb.gearDeferred(),
+          (unsigned)maxWaitUs, (unsigned)boundUs);
+
+  idleTouchCheck(hal, seconds < 10 ? seconds : 10);
+  fprintf(stderr, "[ARB] violations=%u\n", (unsigned)hal.violations);
+  return hal.violations ? 1 : 0;
+}
@@ -0,0 +1,260 @@
+// Host-owy odtwarzacz impulsów zapłonu dla toru RPM z src/.
+// Uruchamia dokładnie ten sam RpmAcquisition co firmware, ale z wirtualnym zegarem.
+//
+// Kompilacja (z katalogu repo, profil jak w platformio.ini, np. -DENGINE_PROFILE_2T=1):
+//   g++ -std=gnu++17 -O2 -Isrc -Itools/replay tools/replay/pulse_replay.cpp -o pulse_replay
+//
+// Użycie:
+//   pulse_replay <plik_impulsow> [--tick-us N] [--sample-ms N] [--horizon-ms N] [-o wynik.csv]
+//                [--telemetry-ms N] [--shift-us N] [--render-ms N]
+//                [--max-rms N] [--max-err N] [--max-p99-us N] [--max-led-p99-us N] [--max-draw-p99-us N]
+//   pulse_replay --bench [--rate-hz N] [--seconds N]
+//
+// Plik impulsów: jedna linia na zbocze "t_us [rpm_ref]", '#' zaczyna komentarz.
+// Kolumna rpm_ref (prawdziwe RPM w chwili t_us) jest opcjonalna – gdy jest,
+// na stderr raportujemy błąd śledzenia (RMS/max) przewidywanego RPM.
+// Wynik: CSV "t_us,rpm" próbkowany co --sample-ms (domyślnie takt rysowania RENDER_PERIOD_MS = 50 ms).
+// Na stderr także p50/p99 opóźnienia impuls -> wartość dla wszystkich etapów [LAT] z firmware,
+// z taktami jak w src/main.cpp (zmiana: --telemetry-ms, --shift-us, --render-ms):
+//   rpm  – migawka telemetrii co 20 ms (publikowana przy zmianie RPM),
+//   led  – lampka zmiany biegu co 2 ms z wejść publikowanych po każdym nowym zboczu,
+//          od zbocza, które zmieniło strefę progu (rampa/zmiana/odcinka), do pierwszej
+//          zmiany jasności po niej – samo miganie nie jest pomiarem (bieg nieznany -> SHIFT_RPM),
+//   draw – rysowanie co 50 ms, gdy migawka się zmieniła (bez czasu samego TFT).
+// Progi --max-* (0 = bez sprawdzania): przekroczenie błędu śledzenia (RMS/max, RPM) albo p99
+// opóźnienia etapu rpm/led/draw daje kod wyjścia 1. Stałe (syntetyczne) próbki z progami: tools/replay/data/,
+// wszystkie sprawdza tools/replay/run_checks.sh.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include "RpmAcquisition.h"
+#include "LatencyStats.h"
+#include "ShiftLight.h"
+#include "ReplayFile.h"
+
+static const uint32_t RPM_IRQ_DEBOUNCE_US = 2000; // jak w src/main.cpp
+
+// Etapy jak LatencyStage w src/main.cpp
+enum LatencyStage { LAT_RPM, LAT_SHIFT_LED, LAT_DRAW, LAT_STAGES };
+static const char* const LATENCY_STAGE_NAMES[LAT_STAGES] = { "rpm", "led", "draw" };
+
+struct Periods { uint32_t telemetryMs = 20, shiftUs = 2000, renderMs = 50; };
+
+// Referencyjne RPM w chwili tUs – interpolacja liniowa między zboczami
+static double refAt(const std::vector<Edge>& edges, size_t& cursor, uint64_t tUs) {
+  while (cursor + 1 < edges.size() && edges[cursor + 1].tUs <= tUs) cursor++;
+  if (cursor + 1 >= edges.size() || edges[cursor].tUs > tUs) return edges[cursor].refRpm;
+  const Edge& a = edges[cursor];
+  const Edge& b = edges[cursor + 1];
+  double k = (double)(tUs - a.tUs) / (double)(b.tUs - a.tUs);
+  return a.refRpm + (b.refRpm - a.refRpm) * k;
+}
+
+struct Limits { double maxRms = 0, maxErr = 0; uint32_t maxP99Us[LAT_STAGES] = {}; };
+
+static int runReplay(const char* inPath, const char* outPath, uint32_t tickUs, uint32_t sampleMs, uint32_t horizonMs,
+                     const Periods& per, const Limits& lim) {
+  std::vector<Edge> edges;
+  bool hasRef = false;
+  if (!loadEdges(inPath, edges, hasRef, "[REPLAY]")) return 1;
+  FILE* out = outPath ? fopen(outPath, "w") : stdout;
+  if (!out) { fprintf(stderr, "[REPLAY] nie mogę zapisać %s\n", outPath); return 1; }
+  fprintf(out, "t_us,rpm\n");
+
+  RpmAcquisition<ActiveEngine> acq(RPM_IRQ_DEBOUNCE_US);
+  size_t next = 0, refCursor = 0;
+  uint64_t startUs = edges.empty() ? 0 : edges.front().tUs;
+  uint64_t endUs = edges.empty() ? 0 : edges.back().tUs + 1000000;
+  uint64_t nextSampleUs = startUs;
+  double errSq = 0, errMax = 0;
+  uint32_t samples = 0;
+  LatencyStats<> latency[LAT_STAGES];
+
+  // Etapy za torem RPM: lampka z migawki wejść, rysowanie z migawki telemetrii
+  ShiftLight<ActiveEngine> shiftLight;
+  ShiftLight<ActiveEngine>::Input shiftIn = {};
+  shiftIn.gear = -1;
+  uint8_t lastDuty = 0;
+  ShiftLight<ActiveEngine>::Zone lastZone = ShiftLight<ActiveEngine>::ZONE_OFF;
+  bool zonePending = false;
+  uint32_t zoneEdgeUs = 0;
+  uint16_t telemetryRpm = 0;
+  uint32_t telemetryEdgeUs = 0, telemetryVersion = 0, drawnVersion = 0;
+  uint64_t nextTelemetryUs = startUs, nextShiftUs = startUs, nextRenderUs = startUs;
+  const uint64_t lastEdgeUs = edges.empty() ? 0 : edges.back().tUs;
+
+  for (uint64_t now = startUs; now <= endUs; now += tickUs) {
+    // "Przerwania": zbocza, które wypadły do tej chwili, z ich własnym znacznikiem czasu
+    while (next < edges.size() && edges[next].tUs <= now) {
+      acq.onEdge((uint32_t)edges[next].tUs);
+      next++;
+    }
+    // "Pętla główna" – nowy pomiar od razu do lampki (publishShiftInput)
+    if (acq.poll()) {
+      shiftIn.rpm = acq.rpmAt((uint32_t)now, 0);
+      shiftIn.rateRpmPerSec = acq.tracker().rateRpmPerSec();
+      shiftIn.sampleUs = (uint32_t)now;
+      shiftIn.edgeUs = acq.tracker().lastEdgeUs();
+    }
+    bool measuring = now <= lastEdgeUs;
+    if (now >= nextTelemetryUs) {
+      nextTelemetryUs += (uint64_t)per.telemetryMs * 1000;
+      uint16_t rpm = acq.rpmAt((uint32_t)now);
+      if (rpm > 0 && measuring) latency[LAT_RPM].record((uint32_t)now - acq.tracker().lastEdgeUs());
+      if (rpm != telemetryRpm) {
+        telemetryRpm = rpm;
+        telemetryEdgeUs = acq.tracker().lastEdgeUs();
+        telemetryVersion++;
+      }
+    }
+    // Takty lampki i rysowania wypadające między taktami pętli – z ich własnym czasem
+    for (; nextShiftUs <= now; nextShiftUs += per.shiftUs) {
+      ShiftLight<ActiveEngine>::Zone zone = shiftLight.zone(shiftIn, (uint32_t)nextShiftUs);
+      if (zone != lastZone) {
+        lastZone = zone;
+        zonePending = shiftIn.rpm > 0 && measuring;
+        zoneEdgeUs = shiftIn.edgeUs;
+      }
+      uint8_t duty = shiftLight.duty(shiftIn, (uint32_t)nextShiftUs);
+      if (duty == lastDuty) continue;
+      lastDuty = duty;
+      if (zonePending) latency[LAT_SHIFT_LED].record((uint32_t)nextShiftUs - zoneEdgeUs);
+      zonePending = false;
+    }
+    for (; nextRenderUs <= now; nextRenderUs += (uint64_t)per.renderMs * 1000) {
+      if (telemetryVersion == drawnVersion) continue;
+      drawnVersion = telemetryVersion;
+      if (telemetryRpm > 0 && measuring) latency[LAT_DRAW].record((uint32_t)nextRenderUs - telemetryEdgeUs);
+    }
+    if (now >= nextSampleUs) {
+      nextSampleUs += (uint64_t)sampleMs * 1000;
+      uint16_t rpm = acq.rpmAt((uint32_t)now, horizonMs);
+      fprintf(out, "%llu,%u\n", (unsigned long long)now, rpm);
+      if (hasRef && acq.tracker().locked() && now + horizonMs * 1000ULL <= edges.back().tUs) {
+        double err = fabs(rpm - refAt(edges, refCursor, now + horizonMs * 1000ULL));
+        errSq += err * err;
+        if (err > errMax) errMax = err;
+        samples++;
+      }
+    }
+  }
+  if (out != stdout) fclose(out);
+
+  fprintf(stderr, "[REPLAY] edges=%u rejected=%u overflows=%u missed=%u noise=%u\n",
+          (unsigned)edges.size(), (unsigned)acq.rejected(), (unsigned)acq.overflows(),
+          (unsigned)acq.missedPulses(), (unsigned)acq.noisePulses());
+  if (latency[LAT_RPM].count() > 0) {
+    fprintf(stderr, "[LAT]");
+    for (uint8_t i = 0; i < LAT_STAGES; i++) {
+      fprintf(stderr, " %s p50=%uus p99=%uus max=%uus n=%u", LATENCY_STAGE_NAMES[i],
+              (unsigned)latency[i].percentileUs(50), (unsigned)latency[i].percentileUs(99),
+              (unsigned)latency[i].maxUs(), (unsigned)latency[i].count());
+    }
+    fprintf(stderr, "\n");
+  }
+  double rms = samples > 0 ? sqrt(errSq / samples) : 0;
+  if (samples > 0) {
+    fprintf(stderr, "[REPLAY] tracking error (horizon %u ms): rms=%.1f max=%.1f rpm over %u samples\n",
+            (unsigned)horizonMs, rms, errMax, (unsigned)samples);
+  }
+
+  int rc = 0;
+  if ((lim.maxRms > 0 || lim.maxErr > 0) && samples == 0) {
+    fprintf(stderr, "[REPLAY] FAIL: brak kolumny rpm_ref albo próbek do oceny błędu\n");
+    rc = 1;
+  }
+  if (lim.maxRms > 0 && rms > lim.maxRms) {
+    fprintf(stderr, "[REPLAY] FAIL: rms %.1f > %.1f rpm\n", rms, lim.maxRms);
+    rc = 1;
+  }
+  if (lim.maxErr > 0 && errMax > lim.maxErr) {
+    fprintf(stderr, "[REPLAY] FAIL: max %.1f > %.1f rpm\n", errMax, lim.maxErr);
+    rc = 1;
+  }
+  for (uint8_t i = 0; i < LAT_STAGES; i++) {
+    if (lim.maxP99Us[i] == 0) continue;
+    uint32_t p99 = latency[i].count() > 0 ? latency[i].percentileUs(99) : UINT32_MAX;
+    if (p99 > lim.maxP99Us[i]) {
+      fprintf(stderr, "[REPLAY] FAIL: %s p99 %uus > %uus\n", LATENCY_STAGE_NAMES[i], (unsigned)p99,
+              (unsigned)lim.maxP99Us[i]);
+      rc = 1;
+    }
+  }
+  return rc;
+}
+
+// Przepustowość toru: ile zboczy/s przejdzie przez onEdge + poll na hoście
+static int runBench(uint32_t rateHz, uint32_t seconds) {
+  RpmAcquisition<ActiveEngine> acq(0);
+  uint64_t total = (uint64_t)rateHz * seconds;
+  double periodUs = 1e6 / rateHz;
+  uint32_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < total; i++) {
+    uint32_t tUs = (uint32_t)(i * periodUs);
+    acq.onEdge(tUs);
+    if ((i & 15) == 15) {
+      acq.poll();
+      sink += acq.rpmAt(tUs);
+    }
+  }
+  acq.poll();
+  double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  fprintf(stderr, "[BENCH] %llu edges @ %u Hz virtual: %.3f s host, %.1f M edges/s, %.1f ns/edge (sink %u)\n",
+          (unsigned long long)total, (unsigned)rateHz, s, total / s / 1e6, s * 1e9 / total, (unsigned)sink);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  const char* inPath = nullptr;
+  const char* outPath = nullptr;
+  bool bench = false;
+  uint32_t tickUs = 1000, sampleMs = 50, horizonMs = ActiveEngine::PREDICT_MS;
+  uint32_t rateHz = 1000000, seconds = 10;
+  Periods per;
+  Limits lim;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    bool hasVal = i + 1 < argc;
+    if (!strcmp(a, "--bench")) bench = true;
+    else if (!strcmp(a, "--tick-us") && hasVal) tickUs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--sample-ms") && hasVal) sampleMs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--horizon-ms") && hasVal) horizonMs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--rate-hz") && hasVal) rateHz = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--seconds") && hasVal) seconds = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--max-rms") && hasVal) lim.maxRms = atof(argv[++i]);
+    else if (!strcmp(a, "--max-err") && hasVal) lim.maxErr = atof(argv[++i]);
+    else if (!strcmp(a, "--telemetry-ms") && hasVal) per.telemetryMs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--shift-us") && hasVal) per.shiftUs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--render-ms") && hasVal) per.renderMs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--max-p99-us") && hasVal) lim.maxP99Us[LAT_RPM] = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--max-led-p99-us") && hasVal) lim.maxP99Us[LAT_SHIFT_LED] = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "--max-draw-p99-us") && hasVal) lim.maxP99Us[LAT_DRAW] = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(a, "-o") && hasVal) outPath = argv[++i];
+    else if (a[0] != '-') inPath = a;
+    else { fprintf(stderr, "[REPLAY] nieznana opcja %s\n", a); return 2; }
+  }
+  if (tickUs == 0) tickUs = 1;
+  if (sampleMs == 0) sampleMs = 1;
+  if (rateHz == 0) rateHz = 1;
+  if (per.telemetryMs == 0) per.telemetryMs = 1;
+  if (per.shiftUs == 0) per.shiftUs = 1;
+  if (per.renderMs == 0) per.renderMs = 1;
+
+  if (bench) return runBench(rateHz, seconds);
+  if (!inPath) {
+    fprintf(stderr, "użycie: %s <plik_impulsow> [--tick-us N] [--sample-ms N] [--horizon-ms N] [-o wynik.csv]\n"
+                    "        [--telemetry-ms N] [--shift-us N] [--render-ms N]\n"
+                    "        [--max-rms N] [--max-err N] [--max-p99-us N] [--max-led-p99-us N] [--max-draw-p99-us N]\n"
+                    "        %s --bench [--rate-hz N] [--seconds N]\n", argv[0], argv[0]);
+    return 2;
+  }
+  return runReplay(inPath, outPath, tickUs, sampleMs, horizonMs, per, lim);
+}
@@ -0,0 +1,127 @@
+// Fuzzing toru RPM: zaszumiony odcinek (zgubione iskry, dzwonienie, EMI) + czysty odcinek.
+// Sprawdza, że estymata (z predykcją) nie wychodzi ponad prawdziwy szczyt scenariusza z zapasem
+// na predykcję – bez dodatkowych zboczy na całym zaszumionym odcinku, zawsze po powrocie
+// (seria zakłóceń może celowo przestawić filtr na nowy rytm) – i że po ustaniu zakłóceń
+// estymata wraca do prawdziwego RPM w ograniczonej liczbie impulsów.
+//
+// Samodzielnie (losowe seedy):
+//   g++ -std=gnu++17 -O2 -Isrc tools/replay/rpm_fuzz.cpp -o rpm_fuzz && ./rpm_fuzz [iteracje]
+// libFuzzer:
+//   clang++ -std=gnu++17 -O1 -g -fsanitize=fuzzer,address -DRPM_FUZZ_LIBFUZZER -Isrc tools/replay/rpm_fuzz.cpp -o rpm_fuzz
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "RpmAcquisition.h"
+#include "SignalGen.h"
+
+using namespace signalgen;
+
+static const uint32_t RPM_IRQ_DEBOUNCE_US = 2000; // jak w src/main.cpp
+static const uint32_t RECOVERY_PULSES = 24;       // limit impulsów na powrót do prawdy
+static const double RECOVERY_TOLERANCE = 0.05;    // dopuszczalny błąd po powrocie
+static const double PEAK_MARGIN = 0.10;           // zapas nad prawdziwym szczytem (jitter)
+static const double PEAK_MARGIN_RPM = 200;
+
+// Parametry scenariusza z bajtów wejścia – każdy bajt steruje jednym pokrętłem
+struct ByteReader {
+  const uint8_t* d; size_t n; size_t i;
+  uint8_t next() { return i < n ? d[i++] : 0; }
+  double unit() { return next() / 255.0; }
+};
+
+static bool runCase(const uint8_t* data, size_t size) {
+  ByteReader in{data, size, 0};
+  const double revsPerPulse = (double)ActiveEngine::REVS_PER_CYCLE / ActiveEngine::PULSES_PER_CYCLE;
+  const double maxRpm = ActiveEngine::REDLINE_RPM;
+
+  Scenario noisy;
+  uint8_t mode = in.next();
+  noisy.shape = (mode & 1) ? SHAPE_SWEEP : SHAPE_IDLE;
+  noisy.idleRpm = 800 + in.unit() * (maxRpm - 800);
+  noisy.sweepFromRpm = 800 + in.unit() * 2000;
+  noisy.sweepToRpm = noisy.sweepFromRpm + in.unit() * (maxRpm - noisy.sweepFromRpm);
+  noisy.sweepSeconds = 0.5 + in.unit() * 3;
+  noisy.seconds = 0.2 + in.unit() * 3;
+  noisy.noise.missProb = in.unit() * 0.3;
+  noisy.noise.doubleProb = in.unit() * 0.5;
+  noisy.noise.ringMinUs = 20 + in.next() * 10;
+  noisy.noise.ringMaxUs = noisy.noise.ringMinUs + in.next() * 20;
+  noisy.noise.burstPerSec = in.unit() * 10;
+  noisy.noise.burstEdges = 1 + in.next() / 4;
+  noisy.noise.burstSpanUs = 100 + in.next() * 100;
+  noisy.noise.jitter = in.unit() * 0.05;
+  // Co drugi przypadek bez dodatkowych zboczy – wtedy szczyt obowiązuje od pierwszego impulsu
+  const bool extraEdges = mode & 2;
+  if (!extraEdges) noisy.noise.doubleProb = noisy.noise.burstPerSec = 0;
+  // Kolejne bajty osobno – kolejność wywołań w jednym wyrażeniu jest nieokreślona
+  uint32_t seed = in.next();
+  seed |= (uint32_t)in.next() << 8;
+  seed |= (uint32_t)in.next() << 16;
+  seed |= (uint32_t)in.next() << 24;
+
+  Scenario clean;
+  clean.shape = SHAPE_IDLE;
+  clean.idleRpm = 1000 + in.unit() * (maxRpm - 1000);
+  clean.seconds = 2.0;
+
+  std::vector<Edge> edges = generate(noisy, revsPerPulse, seed);
+  uint64_t cleanStart = (edges.empty() ? 1000000 : edges.back().tUs);
+  std::vector<Edge> tail = generate(clean, revsPerPulse, seed ^ 0xA5A5A5A5u, cleanStart);
+  size_t firstClean = edges.size();
+  edges.insert(edges.end(), tail.begin(), tail.end());
+
+  double peakRpm = 0;
+  for (const Edge& e : edges) peakRpm = fmax(peakRpm, e.refRpm);
+  // Predykcja może wyprzedzić prawdę o co najwyżej MAX_RATE * PREDICT_MS
+  const double rpmBound = peakRpm * (1.0 + PEAK_MARGIN) + PEAK_MARGIN_RPM +
+                          (double)RpmTracker<ActiveEngine>::MAX_RATE * ActiveEngine::PREDICT_MS / 1000;
+
+  RpmAcquisition<ActiveEngine> acq(RPM_IRQ_DEBOUNCE_US);
+  for (size_t i = 0; i < edges.size(); i++) {
+    uint32_t tUs = (uint32_t)edges[i].tUs;
+    acq.onEdge(tUs);
+    acq.poll();
+    uint16_t rpm = acq.rpmAt(tUs);
+    // Przejście na czysty odcinek to skok RPM niemożliwy fizycznie – szczyt znów po powrocie
+    bool settled = i < firstClean ? !extraEdges : i >= firstClean + RECOVERY_PULSES;
+    if (settled && rpm > rpmBound) {
+      fprintf(stderr, "[FUZZ] rpm=%u > szczyt %.0f (+zapas) przy zboczu %u (seed %u)\n",
+              rpm, peakRpm, (unsigned)i, (unsigned)seed);
+      return false;
+    }
+    if (i >= firstClean + RECOVERY_PULSES) {
+      double ref = edges[i].refRpm;
+      uint16_t now = acq.rpmAt(tUs, 0);
+      if (fabs(now - ref) > ref * RECOVERY_TOLERANCE) {
+        fprintf(stderr, "[FUZZ] brak powrotu: rpm=%u ref=%.0f po %u czystych impulsach (seed %u)\n",
+                now, ref, (unsigned)(i - firstClean), (unsigned)seed);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#ifdef RPM_FUZZ_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  if (!runCase(data, size)) abort();
+  return 0;
+}
+#else
+int main(int argc, char** argv) {
+  uint32_t iterations = argc > 1 ? (uint32_t)atol(argv[1]) : 2000;
+  Rng rng(12345);
+  uint8_t buf[32];
+  uint32_t failures = 0;
+  for (uint32_t it = 0; it < iterations; it++) {
+    for (uint8_t& b : buf) b = (uint8_t)rng.next();
+    if (!runCase(buf, sizeof(buf))) failures++;
+  }
+  fprintf(stderr, "[FUZZ] %u przypadków, %u błędów\n", (unsigned)iterations, (unsigned)failures);
+  return failures ? 1 : 0;
+}
+#endif
@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+# Buduje narzędzia host-owe z tools/replay i uruchamia wszystkie sprawdzenia z progami:
+#   rpm_fuzz, pin_arbiter_check oraz polecenie "Sprawdzenie:" z nagłówka każdej
+#   stałej próbki w tools/replay/data/ (trzecia linia pliku, "#   <narzędzie> <argumenty>").
+# Kod wyjścia != 0 przy pierwszym błędzie kompilacji lub przekroczonym progu.
+#
+# Użycie (z dowolnego katalogu):
+#   tools/replay/run_checks.sh [katalog_builda]     (domyślnie tymczasowy)
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "$0")/../.." && pwd)"
+cd "$ROOT"
+
+if [ $# -gt 0 ]; then
+  BIN="$1"
+  mkdir -p "$BIN"
+else
+  BIN="$(mktemp -d)"
+  trap 'rm -rf "$BIN"' EXIT
+fi
+
+CXX="${CXX:-g++}"
+TOOLS="signal_gen pulse_replay rpm_fuzz gesture_replay pin_arbiter_check led_bar_sim"
+
+for tool in $TOOLS; do
+  echo "[BUILD] $tool"
+  "$CXX" -std=gnu++17 -O2 -Wall -Isrc -Itools/replay "tools/replay/$tool.cpp" -o "$BIN/$tool"
+done
+
+echo "[CHECK] rpm_fuzz"
+"$BIN/rpm_fuzz" 2000
+echo "[CHECK] pin_arbiter_check"
+"$BIN/pin_arbiter_check"
+
+for fixture in tools/replay/data/*.txt; do
+  # Polecenie z nagłówka próbki; nazwa narzędzia wskazuje binarkę z tego builda
+  cmd="$(sed -n '3s/^#[[:space:]]*//p' "$fixture")"
+  tool="${cmd%% *}"
+  case " $TOOLS " in
+    *" $tool "*) ;;
+    *) echo "[CHECK] $fixture: brak polecenia sprawdzenia w 3. linii nagłówka" >&2; exit 1 ;;
+  esac
+  echo "[CHECK] $cmd"
+  read -r -a args <<< "${cmd#* }"
+  "$BIN/$tool" "${args[@]}"
+done
+
+echo "[CHECK] OK"
@@ -0,0 +1,58 @@
+// Generator syntetycznych strumieni zboczy dla pulse_replay (patrz SignalGen.h).
+//
+// Kompilacja:
+//   g++ -std=gnu++17 -O2 -Isrc tools/replay/signal_gen.cpp -o signal_gen
+//
+// Użycie:
+//   signal_gen <idle|sweep|missed|ringing|emi> [--seed N] [--seconds S] [--revs-per-pulse R] > impulsy.txt
+//   pulse_replay impulsy.txt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EngineProfile.h"
+#include "SignalGen.h"
+
+using namespace signalgen;
+
+static bool preset(const char* name, Scenario& sc) {
+  if (!strcmp(name, "idle")) {
+    sc.shape = SHAPE_IDLE;
+    sc.noise.jitter = 0.02;
+  } else if (!strcmp(name, "sweep")) {
+    sc.shape = SHAPE_SWEEP;
+    sc.noise.jitter = 0.01;
+  } else if (!strcmp(name, "missed")) {
+    sc.shape = SHAPE_SWEEP;
+    sc.noise.missProb = 0.05;
+  } else if (!strcmp(name, "ringing")) {
+    sc.shape = SHAPE_SWEEP;
+    sc.noise.doubleProb = 0.1;
+  } else if (!strcmp(name, "emi")) {
+    sc.shape = SHAPE_SWEEP;
+    sc.noise.burstPerSec = 2.0;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "użycie: %s <idle|sweep|missed|ringing|emi> [--seed N] [--seconds S] [--revs-per-pulse R]\n", argv[0]);
+    return 2;
+  }
+  Scenario sc;
+  if (!preset(argv[1], sc)) { fprintf(stderr, "[GEN] nieznany scenariusz %s\n", argv[1]); return 2; }
+  uint32_t seed = 1;
+  double revsPerPulse = (double)ActiveEngine::REVS_PER_CYCLE / ActiveEngine::PULSES_PER_CYCLE;
+  for (int i = 2; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--seed")) seed = (uint32_t)strtoul(argv[i + 1], nullptr, 0);
+    else if (!strcmp(argv[i], "--seconds")) sc.seconds = atof(argv[i + 1]);
+    else if (!strcmp(argv[i], "--revs-per-pulse")) revsPerPulse = atof(argv[i + 1]);
+    else { fprintf(stderr, "[GEN] nieznana opcja %s\n", argv[i]); return 2; }
+  }
+  write(stdout, generate(sc, revsPerPulse, seed));
+  return 0;
+}